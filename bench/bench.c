@@ -0,0 +1,151 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  bench.c
+** Module       :  bench
+** Author       :  SH
+** Created      :  2025-09-06 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoView benchmark harness
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "bench.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef NANOVIEW_PROFILE
+#include <nanoview.h>
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    const char *name;
+    void (*run)(void);
+} nkBenchSuite_t;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static size_t failedChecks = 0;
+
+static const nkBenchSuite_t suites[] = {
+    { "traversal", nkBench_Traversal },
+    { "parallel", nkBench_Parallel },
+    { "canvas", nkBench_Canvas },
+    { "wrap", nkBench_Wrap },
+    { "scenes", nkBench_Scenes },
+    { "scroll", nkBench_Scroll },
+};
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+/* usage: nanoview_bench [suite...], runs every suite when none are named.
+   Exits with 1 if a check failed. */
+int main(int argc, char **argv)
+{
+    printf("%-12s %-28s %10s %14s %12s\n", "suite", "benchmark", "nodes", "total ns", "ns/op");
+
+    for (size_t i = 0; i < sizeof(suites) / sizeof(suites[0]); i++)
+    {
+        bool selected = (argc < 2);
+
+        for (int arg = 1; arg < argc; arg++)
+        {
+            if (strcmp(argv[arg], suites[i].name) == 0)
+            {
+                selected = true;
+            }
+        }
+
+        if (selected)
+        {
+            suites[i].run();
+        }
+    }
+
+#ifdef NANOVIEW_PROFILE
+    /* callback time per view type over every suite that ran */
+    printf("\n%-20s %-8s %12s %14s %12s\n", "type", "phase", "calls", "total ns", "max ns");
+
+    static const char *phaseNames[NK_PROFILE_PHASE_COUNT] = {"measure", "arrange", "draw"};
+
+    for (size_t i = 0; i < nkProfiler_TypeCount(); i++)
+    {
+        const nkProfileType_t *type = nkProfiler_Type(i);
+
+        for (int phase = 0; phase < NK_PROFILE_PHASE_COUNT; phase++)
+        {
+            const nkProfileStats_t *stats = &type->phases[phase];
+
+            if (stats->calls > 0)
+            {
+                printf("%-20s %-8s %12llu %14llu %12llu\n", type->name, phaseNames[phase],
+                    (unsigned long long)stats->calls, (unsigned long long)stats->totalNanoseconds, (unsigned long long)stats->maxNanoseconds);
+            }
+        }
+    }
+#endif
+
+    return (failedChecks > 0) ? 1 : 0;
+}
+
+uint64_t nkBench_Now(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+#endif
+}
+
+void nkBench_Report(const char *suite, const char *name, size_t nodes, uint64_t elapsed, size_t ops)
+{
+    double perOp = (ops > 0) ? (double)elapsed / (double)ops : 0.0;
+
+    printf("%-12s %-28s %10zu %14llu %12.2f\n", suite, name, nodes, (unsigned long long)elapsed, perOp);
+}
+
+void nkBench_Check(const char *suite, const char *name, bool passed)
+{
+    printf("%-12s %-28s %s\n", suite, name, passed ? "ok" : "FAILED");
+
+    failedChecks += !passed;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
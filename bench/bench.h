@@ -0,0 +1,70 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  bench.h
+** Module       :  bench
+** Author       :  SH
+** Created      :  2025-09-06 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoView benchmark harness
+**
+***************************************************************/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* calls made to the stand-in NanoDraw backend */
+typedef struct
+{
+    uint64_t saves;
+    uint64_t restores;
+    uint64_t clips;
+    uint64_t states;    /* colours, gradients and stroke widths */
+    uint64_t shapes;    /* rects and rounded rects */
+    uint64_t texts;
+    uint64_t measures;  /* MeasureText */
+} nkBenchDrawCounts_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* monotonic time in nanoseconds */
+uint64_t nkBench_Now(void);
+
+/* prints one result line: total time and time per operation */
+void nkBench_Report(const char *suite, const char *name, size_t nodes, uint64_t elapsed, size_t ops);
+
+/* prints a correctness check; any failure makes the bench exit nonzero */
+void nkBench_Check(const char *suite, const char *name, bool passed);
+
+/* totals since the last reset, counted by nkdraw_stub.c */
+nkBenchDrawCounts_t nkBench_DrawCounts(void);
+void nkBench_ResetDrawCounts(void);
+
+/* SUITES */
+void nkBench_Traversal(void);
+void nkBench_Parallel(void);
+void nkBench_Canvas(void);
+void nkBench_Wrap(void);
+void nkBench_Scenes(void);
+void nkBench_Scroll(void);
+
+#endif /* BENCH_H */
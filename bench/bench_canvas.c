@@ -0,0 +1,169 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  bench_canvas.c
+** Module       :  bench
+** Author       :  SH
+** Created      :  2025-09-14 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Canvas view pan, render and hit testing with
+**                 50k positioned children. Per-frame cost should
+**                 follow what is on screen, not the child count.
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "bench.h"
+
+#include <nanoview.h>
+#include <views/views.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define CHILD_COUNT 50000
+#define CANVAS_EXTENT 20000.0f /* children are spread over a square this wide */
+#define WINDOW_WIDTH 1280.0f
+#define WINDOW_HEIGHT 800.0f
+#define FRAME_COUNT 200
+#define HIT_COUNT 100000
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    nkDockView_t root;
+    nkCanvasView_t canvas;
+    nkView_t children[CHILD_COUNT];
+} CanvasTree_t;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static uint32_t Random(uint32_t *state);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkBench_Canvas(void)
+{
+    CanvasTree_t *tree = calloc(1, sizeof(CanvasTree_t));
+
+    if (tree == NULL)
+    {
+        return;
+    }
+
+    nkView_t *root = &tree->root.view;
+    nkDrawContext_t *context = (nkDrawContext_t *)tree; /* never dereferenced by the stub */
+    uint32_t seed = 1;
+    uint64_t start;
+
+    nkDockView_Create(&tree->root);
+    nkCanvasView_Create(&tree->canvas);
+    nkView_AddChildView(root, &tree->canvas.view);
+
+    start = nkBench_Now();
+
+    for (size_t i = 0; i < CHILD_COUNT; i++)
+    {
+        nkView_t *child = &tree->children[i];
+
+        nkView_Create(child, "Node");
+        child->backgroundColor = NK_COLOR_BLACK;
+        child->capturePointerAction = true;
+        child->canvasRect = (nkRect_t){
+            (float)(Random(&seed) % (uint32_t)CANVAS_EXTENT),
+            (float)(Random(&seed) % (uint32_t)CANVAS_EXTENT),
+            40.0f + (float)(Random(&seed) % 80),
+            20.0f + (float)(Random(&seed) % 40)
+        };
+
+        nkView_AddChildView(&tree->canvas.view, child);
+    }
+
+    nkView_LayoutTree(root, (nkSize_t){WINDOW_WIDTH, WINDOW_HEIGHT}, context);
+    nkBench_Report("canvas", "build+layout", CHILD_COUNT + 2, nkBench_Now() - start, CHILD_COUNT);
+
+    /* pan diagonally, one layout and render per frame */
+    start = nkBench_Now();
+
+    for (int frame = 0; frame < FRAME_COUNT; frame++)
+    {
+        nkCanvasView_SetOffset(&tree->canvas, (nkPoint_t){frame * 37.0f, frame * 23.0f});
+        nkView_LayoutTree(root, (nkSize_t){WINDOW_WIDTH, WINDOW_HEIGHT}, context);
+        nkView_RenderTree(root, context);
+    }
+
+    nkBench_Report("canvas", "pan-frame", CHILD_COUNT + 2, nkBench_Now() - start, FRAME_COUNT);
+
+    /* zoomed out far enough to see a quarter of the canvas */
+    nkCanvasView_SetZoom(&tree->canvas, WINDOW_WIDTH / (CANVAS_EXTENT / 2.0f));
+
+    start = nkBench_Now();
+
+    for (int frame = 0; frame < FRAME_COUNT / 10; frame++)
+    {
+        nkCanvasView_SetOffset(&tree->canvas, (nkPoint_t){frame * 370.0f, frame * 230.0f});
+        nkView_LayoutTree(root, (nkSize_t){WINDOW_WIDTH, WINDOW_HEIGHT}, context);
+        nkView_RenderTree(root, context);
+    }
+
+    nkBench_Report("canvas", "zoomed-out-frame", CHILD_COUNT + 2, nkBench_Now() - start, FRAME_COUNT / 10);
+
+    nkCanvasView_SetZoom(&tree->canvas, 1.0f);
+    nkView_LayoutTree(root, (nkSize_t){WINDOW_WIDTH, WINDOW_HEIGHT}, context);
+
+    start = nkBench_Now();
+
+    for (size_t i = 0; i < CHILD_COUNT / 10; i++)
+    {
+        nkView_t *child = &tree->children[Random(&seed) % CHILD_COUNT];
+        nkRect_t rect = child->canvasRect;
+
+        rect.x = (float)(Random(&seed) % (uint32_t)CANVAS_EXTENT);
+        nkCanvasView_SetChildRect(&tree->canvas, child, rect);
+    }
+
+    nkView_LayoutTree(root, (nkSize_t){WINDOW_WIDTH, WINDOW_HEIGHT}, context);
+    nkBench_Report("canvas", "move-child", CHILD_COUNT + 2, nkBench_Now() - start, CHILD_COUNT / 10);
+
+    size_t hits = 0;
+    start = nkBench_Now();
+
+    for (size_t i = 0; i < HIT_COUNT; i++)
+    {
+        float x = (float)(Random(&seed) % (uint32_t)WINDOW_WIDTH);
+        float y = (float)(Random(&seed) % (uint32_t)WINDOW_HEIGHT);
+
+        hits += nkView_HitTest(root, x, y) != NULL;
+    }
+
+    nkBench_Report("canvas", "hit-test", CHILD_COUNT + 2, nkBench_Now() - start, HIT_COUNT);
+    printf("canvas       %zu of %d hit tests landed on a child\n", hits, HIT_COUNT);
+
+    nkCanvasView_Destroy(&tree->canvas);
+    free(tree);
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static uint32_t Random(uint32_t *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return (*state >> 16) & 0x7fff;
+}
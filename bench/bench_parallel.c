@@ -0,0 +1,170 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  bench_parallel.c
+** Module       :  bench
+** Author       :  SH
+** Created      :  2025-09-13 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Serial vs parallel measure on a 100k node tree
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "bench.h"
+
+#include <nanoview.h>
+#include <views/views.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define ROW_COUNT 1000
+#define ROW_WIDTH 99 /* ROW_COUNT * (ROW_WIDTH + 1) views in total */
+#define LEAF_WORK 256 /* iterations of synthetic work per leaf measure */
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    nkStackView_t root;
+    nkStackView_t rows[ROW_COUNT];
+    nkView_t leaves[ROW_COUNT * ROW_WIDTH];
+} ParallelTree_t;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static nkSize_t LeafMeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context);
+static void BuildTree(ParallelTree_t *tree);
+static uint64_t InvalidateAndLayout(ParallelTree_t *tree);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkBench_Parallel(void)
+{
+    const size_t nodes = 1 + ROW_COUNT * (ROW_WIDTH + 1);
+
+    ParallelTree_t *tree = calloc(1, sizeof(ParallelTree_t));
+    nkRect_t *serialFrames = malloc(ROW_COUNT * ROW_WIDTH * sizeof(nkRect_t));
+
+    BuildTree(tree);
+
+    /* a speedup needs a core per thread, so say how many there are */
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    printf("%-12s %ld cores online\n", "parallel", cores);
+
+    nkView_SetParallelLayout(1);
+
+    uint64_t serial = InvalidateAndLayout(tree);
+    nkBench_Report("parallel", "layout/serial", nodes, serial, nodes);
+
+    for (size_t i = 0; i < ROW_COUNT * ROW_WIDTH; i++)
+    {
+        serialFrames[i] = tree->leaves[i].frame;
+    }
+
+    for (size_t threads = 2; threads <= 16; threads *= 2)
+    {
+        char name[64];
+
+        if (!nkView_SetParallelLayout(threads))
+        {
+            printf("%-12s built without NANOVIEW_PARALLEL, skipping\n", "parallel");
+            break;
+        }
+
+        uint64_t elapsed = InvalidateAndLayout(tree);
+
+        bool identical = true;
+
+        for (size_t i = 0; i < ROW_COUNT * ROW_WIDTH; i++)
+        {
+            identical = identical && memcmp(&serialFrames[i], &tree->leaves[i].frame, sizeof(nkRect_t)) == 0;
+        }
+
+        snprintf(name, sizeof(name), "layout/%zu-threads", threads);
+        nkBench_Report("parallel", name, nodes, elapsed, nodes);
+
+        printf("%-12s %-28s speedup %.2fx, frames %s%s\n", "", "", (double)serial / (double)elapsed, identical ? "identical" : "DIFFER",
+               ((long)threads > cores) ? ", more threads than cores" : "");
+    }
+
+    nkView_SetParallelLayout(1);
+
+    free(serialFrames);
+    free(tree);
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+/* stands in for an expensive, thread-safe measure such as text shaping */
+static nkSize_t LeafMeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context)
+{
+    uintptr_t seed = (uintptr_t)view;
+    float width = 0.0f;
+
+    for (int i = 0; i < LEAF_WORK; i++)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        width += (float)((seed >> 33) & 0xF) * 0.125f;
+    }
+
+    return (nkSize_t){width / (float)LEAF_WORK * 16.0f, 12.0f};
+}
+
+static void BuildTree(ParallelTree_t *tree)
+{
+    nkStackView_Create(&tree->root);
+    tree->root.orientation = STACK_ORIENTATION_VERTICAL;
+
+    for (size_t row = 0; row < ROW_COUNT; row++)
+    {
+        nkStackView_Create(&tree->rows[row]);
+        nkView_AddChildView(&tree->root.view, &tree->rows[row].view);
+
+        for (size_t i = 0; i < ROW_WIDTH; i++)
+        {
+            nkView_t *leaf = &tree->leaves[row * ROW_WIDTH + i];
+
+            nkView_Create(leaf, "Leaf");
+            leaf->measureSizeCallback = LeafMeasureCallback;
+            leaf->measureThreadSafe = true;
+
+            nkView_AddChildView(&tree->rows[row].view, leaf);
+        }
+    }
+
+    nkView_LayoutTree(&tree->root.view, (nkSize_t){1920.0f, 1080.0f}, NULL);
+}
+
+/* dirties every leaf so the whole tree is re-measured */
+static uint64_t InvalidateAndLayout(ParallelTree_t *tree)
+{
+    for (size_t i = 0; i < ROW_COUNT * ROW_WIDTH; i++)
+    {
+        nkView_InvalidateMeasure(&tree->leaves[i]);
+    }
+
+    uint64_t start = nkBench_Now();
+    nkView_LayoutTree(&tree->root.view, (nkSize_t){1920.0f, 1080.0f}, NULL);
+
+    return nkBench_Now() - start;
+}
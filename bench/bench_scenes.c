@@ -0,0 +1,863 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  bench_scenes.c
+** Module       :  bench
+** Author       :  SH
+** Created      :  2025-09-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Synthetic UI trees (deep, wide, dock-heavy,
+**                 scroll-heavy, 10k labels, stacked opaque layers)
+**                 timed through layout, render (full, retained,
+**                 batched, occlusion culled and damaged),
+**                 hit testing and pointer dispatch. Draw call
+**                 counts per frame are deterministic, so a change
+**                 in them is a behaviour change.
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "bench.h"
+
+#include <nanoview.h>
+#include <views/views.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_WIDTH 1280.0f
+#define WINDOW_HEIGHT 800.0f
+
+#define DEEP_DEPTH 1000         /* nested stacks, each with a leaf beside the next */
+#define WIDE_COUNT 10000        /* leaves in one stack */
+#define DOCK_PANELS 200         /* rows of nested docks */
+#define DOCK_DEPTH 4            /* docks nested inside each panel */
+#define SCROLL_COUNT 100        /* scroll views in a column */
+#define SCROLL_ROWS 50          /* rows inside each scroll view */
+#define LABEL_COUNT 10000
+#define LAYER_COUNT 8           /* opaque panels stacked over each other */
+#define LAYER_ROWS 80           /* rows of leaves in each panel */
+#define LAYER_COLUMNS 16
+
+#define LAYOUT_COUNT 20
+#define IDLE_COUNT 1000
+#define RENDER_COUNT 20
+#define POINTER_COUNT 10000
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    const char *name;
+    nkView_t *root;
+    size_t nodes;
+    nkGridView_t *grid; /* owns its tracks, if the scene has one */
+
+    /* every allocation, freed together */
+    void **blocks;
+    size_t blockCount;
+    size_t blockCapacity;
+} Scene_t;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/* the changing view's own callbacks, run by the counting ones */
+static ViewDrawCallback_t changingDrawCallback;
+static ViewRecordCallback_t changingRecordCallback;
+static size_t changingDraws;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void BuildDeep(Scene_t *scene);
+static void BuildWide(Scene_t *scene);
+static void BuildDocks(Scene_t *scene);
+static void BuildScrolls(Scene_t *scene);
+static void BuildLabels(Scene_t *scene);
+static void BuildLayers(Scene_t *scene);
+
+static void RunScene(Scene_t *scene);
+static nkView_t *FindVisibleView(nkView_t *root, size_t start);
+static nkRect_t ShownRect(nkView_t *view);
+static bool RegionCovers(const nkDamageRegion_t *damage, nkRect_t rect);
+static void CountChangingDraw(nkView_t *view, nkDrawContext_t *context);
+static void CountChangingRecord(nkView_t *view, nkDisplayList_t *list);
+static void PrintDrawCounts(const char *name, int frames);
+static void PrintViewStats(const char *name, int operations);
+static void FreeScene(Scene_t *scene);
+
+static void *NewBlock(Scene_t *scene, size_t size);
+static nkView_t *NewLeaf(Scene_t *scene, float width, float height);
+static nkStackView_t *NewStack(Scene_t *scene, nkStackOrientation_t orientation);
+static nkDockView_t *NewDock(Scene_t *scene);
+static uint32_t Random(uint32_t *state);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkBench_Scenes(void)
+{
+    static void (*const builders[])(Scene_t *scene) = {
+        BuildDeep, BuildWide, BuildDocks, BuildScrolls, BuildLabels, BuildLayers
+    };
+
+    for (size_t i = 0; i < sizeof(builders) / sizeof(builders[0]); i++)
+    {
+        Scene_t scene = {0};
+
+        builders[i](&scene);
+
+        if (scene.root != NULL)
+        {
+            RunScene(&scene);
+        }
+
+        FreeScene(&scene);
+    }
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+/* a chain of vertical stacks, each holding a leaf and the next stack */
+static void BuildDeep(Scene_t *scene)
+{
+    scene->name = "deep";
+
+    nkStackView_t *parent = NewStack(scene, STACK_ORIENTATION_VERTICAL);
+    scene->root = &parent->view;
+
+    for (size_t i = 0; i < DEEP_DEPTH && parent != NULL; i++)
+    {
+        nkView_t *leaf = NewLeaf(scene, 200.0f, 2.0f);
+        nkStackView_t *next = NewStack(scene, STACK_ORIENTATION_VERTICAL);
+
+        if (leaf == NULL || next == NULL)
+        {
+            return;
+        }
+
+        nkView_AddChildView(&parent->view, leaf);
+        nkView_AddChildView(&parent->view, &next->view);
+
+        parent = next;
+    }
+}
+
+static void BuildWide(Scene_t *scene)
+{
+    scene->name = "wide";
+
+    nkStackView_t *stack = NewStack(scene, STACK_ORIENTATION_VERTICAL);
+    scene->root = (stack != NULL) ? &stack->view : NULL;
+
+    for (size_t i = 0; i < WIDE_COUNT && stack != NULL; i++)
+    {
+        nkView_t *leaf = NewLeaf(scene, 20.0f + (float)(i % 7), 10.0f);
+
+        if (leaf == NULL)
+        {
+            return;
+        }
+
+        nkView_AddChildView(&stack->view, leaf);
+    }
+}
+
+/* panels of nested docks, each with a toolbar of buttons, side bars and a
+   status bar around the next dock */
+static void BuildDocks(Scene_t *scene)
+{
+    scene->name = "docks";
+
+    nkStackView_t *column = NewStack(scene, STACK_ORIENTATION_VERTICAL);
+    scene->root = (column != NULL) ? &column->view : NULL;
+
+    for (size_t panel = 0; panel < DOCK_PANELS && column != NULL; panel++)
+    {
+        nkDockView_t *dock = NewDock(scene);
+
+        if (dock == NULL)
+        {
+            return;
+        }
+
+        nkView_AddChildView(&column->view, &dock->view);
+
+        for (size_t depth = 0; depth < DOCK_DEPTH; depth++)
+        {
+            nkStackView_t *toolbar = NewStack(scene, STACK_ORIENTATION_HORIZONTAL);
+            nkView_t *left = NewLeaf(scene, 40.0f, 10.0f);
+            nkView_t *right = NewLeaf(scene, 40.0f, 10.0f);
+            nkView_t *status = NewLeaf(scene, 10.0f, 8.0f);
+            nkDockView_t *inner = NewDock(scene);
+
+            if (toolbar == NULL || left == NULL || right == NULL || status == NULL || inner == NULL)
+            {
+                return;
+            }
+
+            for (size_t i = 0; i < 3; i++)
+            {
+                nkButton_t *button = NewBlock(scene, sizeof(nkButton_t));
+
+                if (button == NULL)
+                {
+                    return;
+                }
+
+                nkButton_Create(button);
+                button->text = "Button";
+                scene->nodes++;
+
+                nkView_AddChildView(&toolbar->view, &button->view);
+            }
+
+            toolbar->view.dockPosition = DOCK_POSITION_TOP;
+            left->dockPosition = DOCK_POSITION_LEFT;
+            right->dockPosition = DOCK_POSITION_RIGHT;
+            status->dockPosition = DOCK_POSITION_BOTTOM;
+
+            nkView_AddChildView(&dock->view, &toolbar->view);
+            nkView_AddChildView(&dock->view, left);
+            nkView_AddChildView(&dock->view, right);
+            nkView_AddChildView(&dock->view, status);
+            nkView_AddChildView(&dock->view, &inner->view);
+
+            dock = inner;
+        }
+    }
+}
+
+/* a column of fixed-size scroll views, each scrolling a stack of rows */
+static void BuildScrolls(Scene_t *scene)
+{
+    scene->name = "scrolls";
+
+    nkStackView_t *column = NewStack(scene, STACK_ORIENTATION_VERTICAL);
+    scene->root = (column != NULL) ? &column->view : NULL;
+
+    for (size_t i = 0; i < SCROLL_COUNT && column != NULL; i++)
+    {
+        nkScrollView_t *scrollView = NewBlock(scene, sizeof(nkScrollView_t));
+        nkStackView_t *rows = NewStack(scene, STACK_ORIENTATION_VERTICAL);
+
+        if (scrollView == NULL || rows == NULL)
+        {
+            return;
+        }
+
+        nkScrollView_Create(scrollView);
+        scrollView->view.sizeRequest = (nkSize_t){400.0f, 120.0f};
+        scene->nodes++;
+
+        for (size_t row = 0; row < SCROLL_ROWS; row++)
+        {
+            nkView_t *leaf = NewLeaf(scene, 380.0f, 16.0f);
+
+            if (leaf == NULL)
+            {
+                return;
+            }
+
+            nkView_AddChildView(&rows->view, leaf);
+        }
+
+        nkView_AddChildView(&scrollView->view, &rows->view);
+        nkView_AddChildView(&column->view, &scrollView->view);
+    }
+}
+
+static void BuildLabels(Scene_t *scene)
+{
+    scene->name = "labels";
+
+    nkStackView_t *stack = NewStack(scene, STACK_ORIENTATION_VERTICAL);
+    scene->root = (stack != NULL) ? &stack->view : NULL;
+
+    /* labels keep a pointer to their text */
+    char *texts = NewBlock(scene, LABEL_COUNT * 16);
+
+    for (size_t i = 0; i < LABEL_COUNT && stack != NULL && texts != NULL; i++)
+    {
+        nkLabel_t *label = NewBlock(scene, sizeof(nkLabel_t));
+
+        if (label == NULL)
+        {
+            return;
+        }
+
+        nkLabel_Create(label);
+        snprintf(&texts[i * 16], 16, "Label %zu", i);
+        label->text = &texts[i * 16];
+        label->view.capturePointerAction = true;
+        scene->nodes++;
+
+        nkView_AddChildView(&stack->view, &label->view);
+    }
+}
+
+/* panels filling the window in one grid cell, so only the last shows */
+static void BuildLayers(Scene_t *scene)
+{
+    scene->name = "layers";
+
+    nkGridView_t *grid = NewBlock(scene, sizeof(nkGridView_t));
+    scene->root = (grid != NULL) ? &grid->view : NULL;
+
+    if (grid == NULL)
+    {
+        return;
+    }
+
+    nkGridView_Create(grid);
+    scene->grid = grid;
+    scene->nodes++;
+
+    for (size_t layer = 0; layer < LAYER_COUNT; layer++)
+    {
+        nkStackView_t *panel = NewStack(scene, STACK_ORIENTATION_VERTICAL);
+
+        if (panel == NULL)
+        {
+            return;
+        }
+
+        panel->view.backgroundColor = NK_COLOR_WHITE;
+
+        for (size_t row = 0; row < LAYER_ROWS; row++)
+        {
+            nkStackView_t *line = NewStack(scene, STACK_ORIENTATION_HORIZONTAL);
+
+            if (line == NULL)
+            {
+                return;
+            }
+
+            for (size_t column = 0; column < LAYER_COLUMNS; column++)
+            {
+                nkView_t *leaf = NewLeaf(scene, WINDOW_WIDTH / LAYER_COLUMNS - 2.0f, WINDOW_HEIGHT / LAYER_ROWS - 2.0f);
+
+                if (leaf == NULL)
+                {
+                    return;
+                }
+
+                nkView_AddChildView(&line->view, leaf);
+            }
+
+            nkView_AddChildView(&panel->view, &line->view);
+        }
+
+        nkView_AddChildView(&grid->view, &panel->view);
+    }
+}
+
+static void RunScene(Scene_t *scene)
+{
+    nkView_t *root = scene->root;
+    nkDrawContext_t *context = (nkDrawContext_t *)scene; /* never dereferenced by the stub */
+    nkSize_t window = {WINDOW_WIDTH, WINDOW_HEIGHT};
+    uint32_t seed = 1;
+    char name[64];
+    uint64_t start;
+
+    start = nkBench_Now();
+    nkView_LayoutTree(root, window, context);
+    snprintf(name, sizeof(name), "%s/layout-first", scene->name);
+    nkBench_Report("scenes", name, scene->nodes, nkBench_Now() - start, 1);
+
+    /* a new width reaches every view */
+    nkView_ResetStats();
+    start = nkBench_Now();
+
+    for (int i = 0; i < LAYOUT_COUNT; i++)
+    {
+        nkView_LayoutTree(root, (nkSize_t){WINDOW_WIDTH - (float)(1 + i % 2), WINDOW_HEIGHT}, context);
+    }
+
+    snprintf(name, sizeof(name), "%s/layout-resize", scene->name);
+    nkBench_Report("scenes", name, scene->nodes, nkBench_Now() - start, LAYOUT_COUNT);
+    PrintViewStats(name, LAYOUT_COUNT);
+
+    /* the same resizes without a renderer */
+    nkFixedTextMetrics_t metrics;
+    nkFixedTextMetrics_Create(&metrics, 7.0f, 14.0f);
+
+    start = nkBench_Now();
+
+    for (int i = 0; i < LAYOUT_COUNT; i++)
+    {
+        nkView_LayoutTreeHeadless(root, (nkSize_t){WINDOW_WIDTH - (float)(1 + i % 2), WINDOW_HEIGHT}, &metrics.metrics);
+    }
+
+    snprintf(name, sizeof(name), "%s/layout-headless", scene->name);
+    nkBench_Report("scenes", name, scene->nodes, nkBench_Now() - start, LAYOUT_COUNT);
+
+    nkView_LayoutTree(root, window, context);
+
+    start = nkBench_Now();
+
+    for (int i = 0; i < IDLE_COUNT; i++)
+    {
+        nkView_LayoutTree(root, window, context);
+    }
+
+    snprintf(name, sizeof(name), "%s/layout-idle", scene->name);
+    nkBench_Report("scenes", name, scene->nodes, nkBench_Now() - start, IDLE_COUNT);
+
+    nkBench_ResetDrawCounts();
+    nkView_ResetStats();
+    start = nkBench_Now();
+
+    for (int i = 0; i < RENDER_COUNT; i++)
+    {
+        nkView_RenderTree(root, context);
+    }
+
+    snprintf(name, sizeof(name), "%s/render", scene->name);
+    nkBench_Report("scenes", name, scene->nodes, nkBench_Now() - start, RENDER_COUNT);
+
+    PrintDrawCounts(name, RENDER_COUNT);
+    PrintViewStats(name, RENDER_COUNT);
+
+    /* the same frames replayed from display lists */
+    nkViewIterator_t iterator;
+
+    for (nkView_t *view = nkView_PreOrderBegin(&iterator, root); view; view = nkView_PreOrderNext(&iterator))
+    {
+        view->retainDrawing = true;
+    }
+
+    nkView_RenderTree(root, context);
+
+    start = nkBench_Now();
+
+    for (int i = 0; i < RENDER_COUNT; i++)
+    {
+        nkView_RenderTree(root, context);
+    }
+
+    snprintf(name, sizeof(name), "%s/render-retained", scene->name);
+    nkBench_Report("scenes", name, scene->nodes, nkBench_Now() - start, RENDER_COUNT);
+
+    /* and through the batching layer */
+    nkView_SetDrawBatching(true);
+    nkView_ResetDrawBatchStats();
+    nkBench_ResetDrawCounts();
+    start = nkBench_Now();
+
+    for (int i = 0; i < RENDER_COUNT; i++)
+    {
+        nkView_RenderTree(root, context);
+    }
+
+    snprintf(name, sizeof(name), "%s/render-batched", scene->name);
+    nkBench_Report("scenes", name, scene->nodes, nkBench_Now() - start, RENDER_COUNT);
+    PrintDrawCounts(name, RENDER_COUNT);
+
+    nkDrawBatchStats_t batchStats = nkView_DrawBatchStats();
+    printf("scenes       %s calls saved per frame: %llu of %llu\n", name,
+        (unsigned long long)((batchStats.submitted - batchStats.issued) / RENDER_COUNT),
+        (unsigned long long)(batchStats.submitted / RENDER_COUNT));
+
+    nkView_SetDrawBatching(false);
+
+    /* skipping what opaque views hide */
+    nkView_SetOcclusionCulling(true);
+    nkBench_ResetDrawCounts();
+    start = nkBench_Now();
+
+    for (int i = 0; i < RENDER_COUNT; i++)
+    {
+        nkView_RenderTree(root, context);
+    }
+
+    snprintf(name, sizeof(name), "%s/render-occluded", scene->name);
+    nkBench_Report("scenes", name, scene->nodes, nkBench_Now() - start, RENDER_COUNT);
+    PrintDrawCounts(name, RENDER_COUNT);
+
+    nkView_SetOcclusionCulling(false);
+
+    /* one visible view in the middle of the tree changes color every frame */
+    nkView_t *changing = FindVisibleView(root, scene->nodes / 2);
+    nkRect_t changed = ShownRect(changing);
+    bool covered = true;
+
+    changingDrawCallback = changing->drawCallback;
+    changingRecordCallback = changing->recordCallback;
+    changingDraws = 0;
+
+    if (changing->recordCallback)
+    {
+        changing->recordCallback = CountChangingRecord;
+    }
+    else
+    {
+        changing->drawCallback = CountChangingDraw;
+    }
+
+    nkDamageRegion_t damage;
+    nkDamageRegion_Create(&damage);
+    nkView_CollectDamage(root, &damage);
+
+    /* an untimed frame builds the hit indexes the damage is found through,
+       as pointer moves over the scene would have */
+    nkView_InvalidateVisual(changing);
+    nkDamageRegion_Clear(&damage);
+    nkView_CollectDamage(root, &damage);
+    nkView_RenderDamage(root, context, &damage);
+    changingDraws = 0;
+
+    nkBench_ResetDrawCounts();
+    start = nkBench_Now();
+
+    for (int i = 0; i < RENDER_COUNT; i++)
+    {
+        nkView_SetBackgroundColor(changing, (i % 2) ? NK_COLOR_BLACK : NK_COLOR_WHITE);
+
+        nkDamageRegion_Clear(&damage);
+        nkView_CollectDamage(root, &damage);
+        covered = covered && RegionCovers(&damage, changed);
+        nkView_RenderDamage(root, context, &damage);
+    }
+
+    snprintf(name, sizeof(name), "%s/render-damaged", scene->name);
+    nkBench_Report("scenes", name, scene->nodes, nkBench_Now() - start, RENDER_COUNT);
+    PrintDrawCounts(name, RENDER_COUNT);
+
+    snprintf(name, sizeof(name), "%s/damage-covers-change", scene->name);
+    nkBench_Check("scenes", name, covered);
+    snprintf(name, sizeof(name), "%s/damage-draws-change", scene->name);
+    nkBench_Check("scenes", name, changingDraws >= RENDER_COUNT);
+
+    changing->drawCallback = changingDrawCallback;
+    changing->recordCallback = changingRecordCallback;
+
+    start = nkBench_Now();
+
+    for (int i = 0; i < IDLE_COUNT; i++)
+    {
+        nkDamageRegion_Clear(&damage);
+        nkView_CollectDamage(root, &damage);
+        nkView_RenderDamage(root, context, &damage);
+    }
+
+    snprintf(name, sizeof(name), "%s/render-idle", scene->name);
+    nkBench_Report("scenes", name, scene->nodes, nkBench_Now() - start, IDLE_COUNT);
+
+    nkDamageRegion_Destroy(&damage);
+
+    size_t hits = 0;
+    nkView_ResetStats();
+    start = nkBench_Now();
+
+    for (int i = 0; i < POINTER_COUNT; i++)
+    {
+        float x = (float)(Random(&seed) % (uint32_t)WINDOW_WIDTH);
+        float y = (float)(Random(&seed) % (uint32_t)WINDOW_HEIGHT);
+
+        hits += nkView_HitTest(root, x, y) != NULL;
+    }
+
+    snprintf(name, sizeof(name), "%s/hit-test", scene->name);
+    nkBench_Report("scenes", name, scene->nodes, nkBench_Now() - start, POINTER_COUNT);
+    PrintViewStats(name, POINTER_COUNT);
+
+    /* a pointer sweeping the window, then clicking wherever it is */
+    nkView_t *hotView = NULL;
+    nkView_t *activeView = NULL;
+    nkPointerAction_t activeAction = NK_POINTER_ACTION_PRIMARY;
+
+    start = nkBench_Now();
+
+    for (int i = 0; i < POINTER_COUNT; i++)
+    {
+        float x = (float)(i % 64) * (WINDOW_WIDTH / 64.0f);
+        float y = (float)(i / 64 % 64) * (WINDOW_HEIGHT / 64.0f);
+
+        nkView_ProcessPointerMovement(root, x, y, &hotView, activeView, activeAction);
+    }
+
+    snprintf(name, sizeof(name), "%s/pointer-move", scene->name);
+    nkBench_Report("scenes", name, scene->nodes, nkBench_Now() - start, POINTER_COUNT);
+
+    /* a fast mouse's stream: a pixel at a time, mostly over the same view */
+    nkView_ResetStats();
+    start = nkBench_Now();
+
+    for (int i = 0; i < POINTER_COUNT; i++)
+    {
+        float x = (float)(i % (int)WINDOW_WIDTH);
+        float y = (float)(i / (int)WINDOW_WIDTH) * 37.0f;
+
+        nkView_ProcessPointerMovement(root, x, y, &hotView, activeView, activeAction);
+    }
+
+    snprintf(name, sizeof(name), "%s/pointer-hover", scene->name);
+    nkBench_Report("scenes", name, scene->nodes, nkBench_Now() - start, POINTER_COUNT);
+    PrintViewStats(name, POINTER_COUNT);
+
+    /* the same stream with the button held */
+    nkView_ProcessPointerAction(root, NK_POINTER_ACTION_PRIMARY, POINTER_EVENT_BEGIN, 0.0f, 0.0f, hotView, &activeView, &activeAction);
+    nkView_ResetStats();
+    start = nkBench_Now();
+
+    for (int i = 0; i < POINTER_COUNT; i++)
+    {
+        float x = (float)(i % (int)WINDOW_WIDTH);
+        float y = (float)(i / (int)WINDOW_WIDTH) * 37.0f;
+
+        nkView_ProcessPointerMovement(root, x, y, &hotView, activeView, activeAction);
+    }
+
+    snprintf(name, sizeof(name), "%s/pointer-drag", scene->name);
+    nkBench_Report("scenes", name, scene->nodes, nkBench_Now() - start, POINTER_COUNT);
+    PrintViewStats(name, POINTER_COUNT);
+
+    nkView_ProcessPointerAction(root, NK_POINTER_ACTION_PRIMARY, POINTER_EVENT_END, 0.0f, 0.0f, hotView, &activeView, &activeAction);
+
+    start = nkBench_Now();
+
+    for (int i = 0; i < POINTER_COUNT; i++)
+    {
+        float x = (float)(Random(&seed) % (uint32_t)WINDOW_WIDTH);
+        float y = (float)(Random(&seed) % (uint32_t)WINDOW_HEIGHT);
+
+        nkView_ProcessPointerMovement(root, x, y, &hotView, activeView, activeAction);
+        nkView_ProcessPointerAction(root, NK_POINTER_ACTION_PRIMARY, POINTER_EVENT_BEGIN, x, y, hotView, &activeView, &activeAction);
+        nkView_ProcessPointerAction(root, NK_POINTER_ACTION_PRIMARY, POINTER_EVENT_END, x, y, hotView, &activeView, &activeAction);
+    }
+
+    snprintf(name, sizeof(name), "%s/pointer-click", scene->name);
+    nkBench_Report("scenes", name, scene->nodes, nkBench_Now() - start, POINTER_COUNT);
+
+    printf("scenes       %s %zu of %d hit tests landed on a view\n", scene->name, hits, POINTER_COUNT);
+}
+
+/* per frame, since the last nkBench_ResetDrawCounts */
+/* the first leaf from pre-order position start on (wrapping round) that
+   shows some of itself, so a change to it damages only a small part */
+static nkView_t *FindVisibleView(nkView_t *root, size_t start)
+{
+    nkViewIterator_t iterator;
+    nkView_t *view = nkView_PreOrderBegin(&iterator, root);
+    nkView_t *found = NULL;
+
+    for (size_t i = 0; view != NULL; i++, view = nkView_PreOrderNext(&iterator))
+    {
+        nkRect_t shown = ShownRect(view);
+
+        if (view->childCount > 0 || shown.width <= 0.0f || shown.height <= 0.0f)
+        {
+            continue;
+        }
+
+        if (i >= start)
+        {
+            return view;
+        }
+
+        found = (found != NULL) ? found : view;
+    }
+
+    return (found != NULL) ? found : root;
+}
+
+/* the part of the view's frame left in its visible region, in window coords */
+static nkRect_t ShownRect(nkView_t *view)
+{
+    nkRect_t visible = nkView_VisibleRegion(view);
+    nkPoint_t offset = nkView_WindowOffset(view);
+
+    float left = fmaxf(visible.x, view->frame.x + offset.x);
+    float top = fmaxf(visible.y, view->frame.y + offset.y);
+    float right = fminf(visible.x + visible.width, view->frame.x + offset.x + view->frame.width);
+    float bottom = fminf(visible.y + visible.height, view->frame.y + offset.y + view->frame.height);
+
+    return (nkRect_t){left, top, fmaxf(0.0f, right - left), fmaxf(0.0f, bottom - top)};
+}
+
+/* the region's rects are disjoint, so their overlaps with rect add up to
+   its area only if they cover it */
+static bool RegionCovers(const nkDamageRegion_t *damage, nkRect_t rect)
+{
+    float area = 0.0f;
+
+    for (size_t i = 0; i < damage->count; i++)
+    {
+        const nkRect_t *r = &damage->rects[i];
+        float width = fminf(r->x + r->width, rect.x + rect.width) - fmaxf(r->x, rect.x);
+        float height = fminf(r->y + r->height, rect.y + rect.height) - fmaxf(r->y, rect.y);
+
+        if (width > 0.0f && height > 0.0f)
+        {
+            area += width * height;
+        }
+    }
+
+    return area >= rect.width * rect.height * 0.999f;
+}
+
+static void CountChangingDraw(nkView_t *view, nkDrawContext_t *context)
+{
+    changingDraws++;
+
+    if (changingDrawCallback)
+    {
+        changingDrawCallback(view, context);
+    }
+}
+
+static void CountChangingRecord(nkView_t *view, nkDisplayList_t *list)
+{
+    changingDraws++;
+    changingRecordCallback(view, list);
+}
+
+static void PrintDrawCounts(const char *name, int frames)
+{
+    nkBenchDrawCounts_t counts = nkBench_DrawCounts();
+
+    printf("scenes       %s draw calls per frame: %llu save %llu restore %llu clip %llu state %llu shape %llu text\n",
+        name,
+        (unsigned long long)(counts.saves / frames),
+        (unsigned long long)(counts.restores / frames),
+        (unsigned long long)(counts.clips / frames),
+        (unsigned long long)(counts.states / frames),
+        (unsigned long long)(counts.shapes / frames),
+        (unsigned long long)(counts.texts / frames));
+}
+
+/* per operation, since the last nkView_ResetStats */
+static void PrintViewStats(const char *name, int operations)
+{
+    nkViewStats_t stats = nkView_Stats();
+
+    printf("scenes       %s view stats per op: %llu visited %llu culled %llu callbacks %llu saves %llu draws %llu hit tested %llu layout\n",
+        name,
+        (unsigned long long)(stats.viewsVisited / operations),
+        (unsigned long long)(stats.viewsCulled / operations),
+        (unsigned long long)(stats.drawCallbacks / operations),
+        (unsigned long long)(stats.saves / operations),
+        (unsigned long long)(stats.drawCalls / operations),
+        (unsigned long long)(stats.hitTestViews / operations),
+        (unsigned long long)(stats.layoutCallbacks / operations));
+}
+
+static void FreeScene(Scene_t *scene)
+{
+    /* releases display lists */
+    nkViewIterator_t iterator;
+
+    for (nkView_t *view = nkView_PreOrderBegin(&iterator, scene->root); view; view = nkView_PreOrderNext(&iterator))
+    {
+        nkView_Destroy(view);
+    }
+
+    nkGridView_Destroy(scene->grid);
+
+    for (size_t i = 0; i < scene->blockCount; i++)
+    {
+        free(scene->blocks[i]);
+    }
+
+    free(scene->blocks);
+
+    scene->blocks = NULL;
+    scene->blockCount = 0;
+    scene->blockCapacity = 0;
+    scene->root = NULL;
+}
+
+/* zeroed, and freed with the scene */
+static void *NewBlock(Scene_t *scene, size_t size)
+{
+    if (scene->blockCount == scene->blockCapacity)
+    {
+        size_t capacity = (scene->blockCapacity > 0) ? scene->blockCapacity * 2 : 1024;
+        void **blocks = realloc(scene->blocks, capacity * sizeof(void *));
+
+        if (blocks == NULL)
+        {
+            return NULL;
+        }
+
+        scene->blocks = blocks;
+        scene->blockCapacity = capacity;
+    }
+
+    void *block = calloc(1, size);
+
+    if (block != NULL)
+    {
+        scene->blocks[scene->blockCount++] = block;
+    }
+
+    return block;
+}
+
+static nkView_t *NewLeaf(Scene_t *scene, float width, float height)
+{
+    nkView_t *leaf = NewBlock(scene, sizeof(nkView_t));
+
+    if (leaf != NULL)
+    {
+        nkView_Create(leaf, "Leaf");
+        leaf->sizeRequest = (nkSize_t){width, height};
+        leaf->backgroundColor = NK_COLOR_BLACK;
+        leaf->capturePointerAction = true;
+        scene->nodes++;
+    }
+
+    return leaf;
+}
+
+static nkStackView_t *NewStack(Scene_t *scene, nkStackOrientation_t orientation)
+{
+    nkStackView_t *stack = NewBlock(scene, sizeof(nkStackView_t));
+
+    if (stack != NULL)
+    {
+        nkStackView_Create(stack);
+        stack->orientation = orientation;
+        scene->nodes++;
+    }
+
+    return stack;
+}
+
+static nkDockView_t *NewDock(Scene_t *scene)
+{
+    nkDockView_t *dock = NewBlock(scene, sizeof(nkDockView_t));
+
+    if (dock != NULL)
+    {
+        nkDockView_Create(dock);
+        scene->nodes++;
+    }
+
+    return dock;
+}
+
+static uint32_t Random(uint32_t *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return (*state >> 16) & 0x7fff;
+}
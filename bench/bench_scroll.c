@@ -0,0 +1,366 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  bench_scroll.c
+** Module       :  bench
+** Author       :  SH
+** Created      :  2025-09-21 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  A scroll view over a 100k-row document, scrolled
+**                 by wheel ticks and repainted through damage. The
+**                 offset only moves the content when drawn, so a
+**                 tick should cost what shows, not the document.
+**                 The same ticks driven by the frame scheduler are
+**                 coalesced into one frame each burst, leaving no
+**                 work for another, and idle frames return without
+**                 touching the tree.
+**                 Rows scrolled into view have their own children
+**                 arranged before they are drawn.
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "bench.h"
+
+#include <nanoview.h>
+#include <nkframescheduler.h>
+#include <views/views.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define ROW_COUNT 100000
+#define ROW_HEIGHT 16.0f
+#define WINDOW_WIDTH 1280.0f
+#define WINDOW_HEIGHT 800.0f
+#define TICK_COUNT 1000
+#define IDLE_COUNT 100000
+#define POINTER_COUNT 10000
+#define BURST_SIZE 4            /* wheel events arriving between two frames */
+#define CELL_ROW_COUNT 1000     /* rows holding a cell, for the reveal check */
+#define REVEAL_PAGES 3
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    nkScrollView_t scrollView;  /* the root, sized to the window */
+    nkView_t page;              /* gives the document the window's width */
+    nkWrapView_t document;      /* one row per line */
+    nkView_t rows[ROW_COUNT];
+} ScrollTree_t;
+
+/* a smaller document whose rows each hold a cell */
+typedef struct
+{
+    nkScrollView_t scrollView;
+    nkView_t page;
+    nkWrapView_t document;
+    nkView_t rows[CELL_ROW_COUNT];
+    nkView_t cells[CELL_ROW_COUNT];
+} CellTree_t;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static nkSize_t MeasurePage(nkView_t *view, nkSize_t available, nkDrawContext_t *context);
+static void ArrangePage(nkView_t *view, nkDrawContext_t *context);
+static void ArrangeRow(nkView_t *view, nkDrawContext_t *context);
+static void CheckRevealedCells(void);
+static void Tick(ScrollTree_t *tree, nkDamageRegion_t *damage, float delta, nkDrawContext_t *context);
+static uint32_t Random(uint32_t *state);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkBench_Scroll(void)
+{
+    ScrollTree_t *tree = calloc(1, sizeof(ScrollTree_t));
+
+    if (tree == NULL)
+    {
+        return;
+    }
+
+    nkView_t *root = &tree->scrollView.view;
+    nkDrawContext_t *context = (nkDrawContext_t *)tree; /* never dereferenced by the stub */
+    nkSize_t window = {WINDOW_WIDTH, WINDOW_HEIGHT};
+    uint32_t seed = 1;
+    uint64_t start;
+
+    nkScrollView_Create(&tree->scrollView);
+    root->sizeRequest = window;
+    nkView_Create(&tree->page, "Page");
+    tree->page.measureSizeCallback = MeasurePage;
+    tree->page.arrangeCallback = ArrangePage;
+    nkView_AddChildView(root, &tree->page);
+    nkWrapView_Create(&tree->document);
+    nkView_AddChildView(&tree->page, &tree->document.view);
+
+    for (size_t i = 0; i < ROW_COUNT; i++)
+    {
+        nkView_t *row = &tree->rows[i];
+
+        nkView_Create(row, "Row");
+        row->sizeRequest = (nkSize_t){WINDOW_WIDTH - 20.0f, ROW_HEIGHT};
+        row->backgroundColor = (i % 2) ? NK_COLOR_BLACK : NK_COLOR_WHITE;
+        row->capturePointerAction = true;
+
+        nkView_AddChildView(&tree->document.view, row);
+    }
+
+    start = nkBench_Now();
+    nkView_LayoutTree(root, window, context);
+    nkBench_Report("scroll", "layout-first", ROW_COUNT + 3, nkBench_Now() - start, 1);
+
+    nkDamageRegion_t damage;
+    nkDamageRegion_Create(&damage);
+    nkView_CollectDamage(root, &damage);
+    nkView_RenderTree(root, context);
+
+    /* down a page at a time, then back up */
+    nkBench_ResetDrawCounts();
+    start = nkBench_Now();
+
+    for (int i = 0; i < TICK_COUNT; i++)
+    {
+        Tick(tree, &damage, (i < TICK_COUNT / 2) ? -1.0f : 1.0f, context);
+    }
+
+    nkBench_Report("scroll", "wheel-tick", ROW_COUNT + 3, nkBench_Now() - start, TICK_COUNT);
+
+    nkBenchDrawCounts_t counts = nkBench_DrawCounts();
+
+    printf("scroll       wheel-tick draw calls per tick: %llu state %llu shape\n",
+        (unsigned long long)(counts.states / TICK_COUNT),
+        (unsigned long long)(counts.shapes / TICK_COUNT));
+
+    /* far into the document, then hit testing the rows showing there */
+    tree->scrollView.verticalScrollOffset = 0.5f;
+    Tick(tree, &damage, 0.0f, context);
+
+    size_t hits = 0;
+    start = nkBench_Now();
+
+    for (int i = 0; i < POINTER_COUNT; i++)
+    {
+        float x = (float)(Random(&seed) % (uint32_t)(WINDOW_WIDTH - 20.0f));
+        float y = (float)(Random(&seed) % (uint32_t)WINDOW_HEIGHT);
+
+        nkView_t *hit = nkView_HitTest(root, x, y);
+
+        hits += (hit != NULL && hit != root);
+    }
+
+    nkBench_Report("scroll", "hit-test", ROW_COUNT + 3, nkBench_Now() - start, POINTER_COUNT);
+    printf("scroll       %zu of %d hit tests landed on a row\n", hits, POINTER_COUNT);
+
+    nkDamageRegion_Destroy(&damage);
+
+    /* bursts of wheel events, one frame each */
+    nkFrameScheduler_t scheduler;
+    nkFrameScheduler_Create(&scheduler, root, window);
+    nkFrameScheduler_RunFrame(&scheduler, context, 0.0);
+
+    size_t frames = 0;
+    size_t leftWork = 0;
+    double now = 0.0;
+    start = nkBench_Now();
+
+    for (int i = 0; i < TICK_COUNT; i++)
+    {
+        for (int event = 0; event < BURST_SIZE; event++)
+        {
+            nkView_ProcessScroll(root, ((i < TICK_COUNT / 2) ? -1.0f : 1.0f) * ROW_HEIGHT / 30.0f, root);
+        }
+
+        now += 1.0 / 60.0;
+
+        while (nkFrameScheduler_NeedsFrame(&scheduler, now))
+        {
+            nkFrameScheduler_RunFrame(&scheduler, context, now);
+            frames++;
+
+            /* rows placed while drawing would damage the frame just drawn */
+            leftWork += nkView_NeedsLayout(root) || nkView_NeedsRender(root);
+        }
+    }
+
+    nkBench_Report("scroll", "scheduler-burst", ROW_COUNT + 3, nkBench_Now() - start, TICK_COUNT);
+    printf("scroll       scheduler-burst %zu frames for %d wheel events\n", frames, TICK_COUNT * BURST_SIZE);
+    nkBench_Check("scroll", "one-frame-per-burst", frames == TICK_COUNT && leftWork == 0);
+
+    /* nothing changes, so the host would be asleep */
+    size_t drawn = 0;
+    double deadline = 0.0;
+    start = nkBench_Now();
+
+    for (int i = 0; i < IDLE_COUNT; i++)
+    {
+        now += 1.0 / 60.0;
+        deadline = nkFrameScheduler_RunFrame(&scheduler, context, now);
+        drawn += (scheduler.damage.count > 0);
+    }
+
+    nkBench_Report("scroll", "scheduler-idle", ROW_COUNT + 3, nkBench_Now() - start, IDLE_COUNT);
+    printf("scroll       scheduler-idle %zu of %d frames drew, next deadline %s\n",
+        drawn, IDLE_COUNT, isinf(deadline) ? "idle" : "pending");
+
+    nkFrameScheduler_Destroy(&scheduler);
+
+    for (size_t i = 0; i < ROW_COUNT; i++)
+    {
+        nkView_Destroy(&tree->rows[i]);
+    }
+
+    nkWrapView_Destroy(&tree->document);
+    nkView_Destroy(&tree->document.view);
+    nkView_Destroy(&tree->page);
+    nkView_Destroy(root);
+    free(tree);
+
+    CheckRevealedCells();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+/* the scroll view offers the page unlimited space */
+static nkSize_t MeasurePage(nkView_t *view, nkSize_t available, nkDrawContext_t *context)
+{
+    return nkView_Measure(view->child, (nkSize_t){WINDOW_WIDTH - 20.0f, available.height}, context);
+}
+
+static void ArrangePage(nkView_t *view, nkDrawContext_t *context)
+{
+    nkView_PlaceView(view->child, view->frame);
+}
+
+/* the row's cell fills it */
+static void ArrangeRow(nkView_t *view, nkDrawContext_t *context)
+{
+    nkView_PlaceView(view->child, view->frame);
+}
+
+/* Scrolls pages of rows the document never placed into view, one scheduler
+   frame each, and hit tests the middle of the window after every frame.
+   Below the scroll view only cells capture the pointer, so hitting one
+   means the row there was arranged and its cell placed over it before the
+   frame drew it. */
+static void CheckRevealedCells(void)
+{
+    CellTree_t *tree = calloc(1, sizeof(CellTree_t));
+
+    if (tree == NULL)
+    {
+        return;
+    }
+
+    nkView_t *root = &tree->scrollView.view;
+    nkDrawContext_t *context = (nkDrawContext_t *)tree;
+    nkSize_t window = {WINDOW_WIDTH, WINDOW_HEIGHT};
+
+    nkScrollView_Create(&tree->scrollView);
+    root->sizeRequest = window;
+    nkView_Create(&tree->page, "Page");
+    tree->page.measureSizeCallback = MeasurePage;
+    tree->page.arrangeCallback = ArrangePage;
+    nkView_AddChildView(root, &tree->page);
+    nkWrapView_Create(&tree->document);
+    nkView_AddChildView(&tree->page, &tree->document.view);
+
+    for (size_t i = 0; i < CELL_ROW_COUNT; i++)
+    {
+        nkView_t *row = &tree->rows[i];
+        nkView_t *cell = &tree->cells[i];
+
+        nkView_Create(row, "Row");
+        row->sizeRequest = (nkSize_t){WINDOW_WIDTH - 20.0f, ROW_HEIGHT};
+        row->arrangeCallback = ArrangeRow;
+
+        nkView_Create(cell, "Cell");
+        cell->sizeRequest = row->sizeRequest;
+        cell->capturePointerAction = true;
+
+        nkView_AddChildView(row, cell);
+        nkView_AddChildView(&tree->document.view, row);
+    }
+
+    nkFrameScheduler_t scheduler;
+    nkFrameScheduler_Create(&scheduler, root, window);
+
+    double now = 0.0;
+    nkFrameScheduler_RunFrame(&scheduler, context, now);
+
+    size_t arranged = 0;
+
+    for (int page = 0; page < REVEAL_PAGES; page++)
+    {
+        nkView_ProcessScroll(root, -WINDOW_HEIGHT / 30.0f, root);
+
+        now += 1.0 / 60.0;
+        nkFrameScheduler_RunFrame(&scheduler, context, now);
+
+        nkView_t *hit = nkView_HitTest(root, WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f);
+
+        arranged += (hit != NULL && hit != root && hit->frame.width > 0.0f && hit->frame.height > 0.0f);
+    }
+
+    nkBench_Check("scroll", "revealed-cell-arranged", arranged == REVEAL_PAGES);
+
+    nkFrameScheduler_Destroy(&scheduler);
+
+    for (size_t i = 0; i < CELL_ROW_COUNT; i++)
+    {
+        nkView_Destroy(&tree->cells[i]);
+        nkView_Destroy(&tree->rows[i]);
+    }
+
+    nkWrapView_Destroy(&tree->document);
+    nkView_Destroy(&tree->document.view);
+    nkView_Destroy(&tree->page);
+    nkView_Destroy(root);
+    free(tree);
+}
+
+/* one frame as a host would run it after a scroll event */
+static void Tick(ScrollTree_t *tree, nkDamageRegion_t *damage, float delta, nkDrawContext_t *context)
+{
+    nkView_t *root = &tree->scrollView.view;
+
+    if (delta != 0.0f)
+    {
+        nkView_ProcessScroll(root, delta * WINDOW_HEIGHT / 30.0f, root);
+    }
+    else
+    {
+        /* offset set directly, so arrange applies it */
+        nkView_InvalidateArrange(root);
+    }
+
+    nkView_LayoutTree(root, (nkSize_t){WINDOW_WIDTH, WINDOW_HEIGHT}, context);
+
+    nkDamageRegion_Clear(damage);
+    nkView_CollectDamage(root, damage);
+    nkView_RenderDamage(root, context, damage);
+}
+
+static uint32_t Random(uint32_t *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return (*state >> 16) & 0x7fff;
+}
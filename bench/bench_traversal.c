@@ -0,0 +1,324 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  bench_traversal.c
+** Module       :  bench
+** Author       :  SH
+** Created      :  2025-09-06 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Traversal scaling benchmarks. Per-node cost
+**                 should stay flat from 1k to 1M nodes.
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "bench.h"
+
+#include <nanoview.h>
+#include <views/views.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define ROW_WIDTH 8 /* views per row in the rows tree */
+#define PLACE_ROUNDS 5 /* alternating timed placements, best kept */
+#define CHECK_BATCH 64 /* views placed at a time by CheckPlacement */
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    nkStackView_t root;
+    nkStackView_t *rows;
+    nkView_t *leaves;
+    size_t nodes;
+} TraversalTree_t;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void BuildFlat(TraversalTree_t *tree, size_t count);
+static void BuildRows(TraversalTree_t *tree, size_t count);
+static void FreeTree(TraversalTree_t *tree);
+static void Run(const char *shape, TraversalTree_t *tree);
+static void RunPlacement(TraversalTree_t *tree, size_t count);
+static void CheckPlacement(void);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkBench_Traversal(void)
+{
+    CheckPlacement();
+
+    for (size_t count = 1000; count <= 1000000; count *= 10)
+    {
+        TraversalTree_t tree;
+
+        BuildFlat(&tree, count);
+        Run("flat", &tree);
+        RunPlacement(&tree, count);
+        FreeTree(&tree);
+
+        BuildRows(&tree, count);
+        Run("rows", &tree);
+        FreeTree(&tree);
+    }
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void InitLeaf(nkView_t *leaf)
+{
+    nkView_Create(leaf, "Leaf");
+    leaf->sizeRequest = (nkSize_t){20.0f, 10.0f};
+    leaf->backgroundColor = NK_COLOR_BLACK;
+}
+
+/* one vertical stack holding every leaf */
+static void BuildFlat(TraversalTree_t *tree, size_t count)
+{
+    nkStackView_Create(&tree->root);
+    tree->root.orientation = STACK_ORIENTATION_VERTICAL;
+
+    tree->rows = NULL;
+    tree->leaves = calloc(count, sizeof(nkView_t));
+    tree->nodes = count + 1;
+
+    nkView_t **children = malloc(count * sizeof(nkView_t *));
+
+    for (size_t i = 0; i < count; i++)
+    {
+        InitLeaf(&tree->leaves[i]);
+        children[i] = &tree->leaves[i];
+    }
+
+    uint64_t start = nkBench_Now();
+    nkView_AddChildViews(&tree->root.view, children, count);
+    nkBench_Report("traversal", "flat/build-bulk", tree->nodes, nkBench_Now() - start, count);
+
+    free(children);
+}
+
+/* a vertical stack of horizontal rows, ROW_WIDTH leaves each */
+static void BuildRows(TraversalTree_t *tree, size_t count)
+{
+    size_t rowCount = count / ROW_WIDTH;
+
+    nkStackView_Create(&tree->root);
+    tree->root.orientation = STACK_ORIENTATION_VERTICAL;
+
+    tree->rows = calloc(rowCount, sizeof(nkStackView_t));
+    tree->leaves = calloc(rowCount * ROW_WIDTH, sizeof(nkView_t));
+    tree->nodes = 1 + rowCount * (ROW_WIDTH + 1);
+
+    uint64_t start = nkBench_Now();
+
+    for (size_t row = 0; row < rowCount; row++)
+    {
+        nkStackView_Create(&tree->rows[row]);
+        nkView_AddChildView(&tree->root.view, &tree->rows[row].view);
+
+        for (size_t i = 0; i < ROW_WIDTH; i++)
+        {
+            nkView_t *leaf = &tree->leaves[row * ROW_WIDTH + i];
+            InitLeaf(leaf);
+            nkView_AddChildView(&tree->rows[row].view, leaf);
+        }
+    }
+
+    nkBench_Report("traversal", "rows/build-append", tree->nodes, nkBench_Now() - start, tree->nodes);
+}
+
+static void FreeTree(TraversalTree_t *tree)
+{
+    free(tree->rows);
+    free(tree->leaves);
+}
+
+static void Run(const char *shape, TraversalTree_t *tree)
+{
+    char name[64];
+    nkView_t *root = &tree->root.view;
+    nkDrawContext_t *context = (nkDrawContext_t *)tree; /* never dereferenced by the stub */
+    nkViewIterator_t iterator;
+    uint64_t start;
+
+    /* first layout measures and arranges everything */
+    start = nkBench_Now();
+    nkView_LayoutTree(root, (nkSize_t){800.0f, 600.0f}, context);
+    snprintf(name, sizeof(name), "%s/layout-initial", shape);
+    nkBench_Report("traversal", name, tree->nodes, nkBench_Now() - start, tree->nodes);
+
+    /* a width change re-measures and re-arranges every view */
+    start = nkBench_Now();
+    nkView_LayoutTree(root, (nkSize_t){1024.0f, 600.0f}, context);
+    snprintf(name, sizeof(name), "%s/layout-resize", shape);
+    nkBench_Report("traversal", name, tree->nodes, nkBench_Now() - start, tree->nodes);
+
+    start = nkBench_Now();
+    nkView_RenderTree(root, context);
+    snprintf(name, sizeof(name), "%s/render", shape);
+    nkBench_Report("traversal", name, tree->nodes, nkBench_Now() - start, tree->nodes);
+
+    start = nkBench_Now();
+    for (nkView_t *view = nkView_PreOrderBegin(&iterator, root); view; view = nkView_PreOrderNext(&iterator)) { }
+    snprintf(name, sizeof(name), "%s/pre-order", shape);
+    nkBench_Report("traversal", name, tree->nodes, nkBench_Now() - start, tree->nodes);
+
+    start = nkBench_Now();
+    for (nkView_t *view = nkView_PostOrderBegin(&iterator, root); view; view = nkView_PostOrderNext(&iterator)) { }
+    snprintf(name, sizeof(name), "%s/post-order", shape);
+    nkBench_Report("traversal", name, tree->nodes, nkBench_Now() - start, tree->nodes);
+
+    /* the same passes over the frozen arrays */
+    start = nkBench_Now();
+    nkView_FreezeSubtree(root);
+    snprintf(name, sizeof(name), "%s/freeze", shape);
+    nkBench_Report("traversal", name, tree->nodes, nkBench_Now() - start, tree->nodes);
+
+    start = nkBench_Now();
+    nkView_LayoutTree(root, (nkSize_t){800.0f, 600.0f}, context);
+    snprintf(name, sizeof(name), "%s/frozen-layout-resize", shape);
+    nkBench_Report("traversal", name, tree->nodes, nkBench_Now() - start, tree->nodes);
+
+    start = nkBench_Now();
+    nkView_RenderTree(root, context);
+    snprintf(name, sizeof(name), "%s/frozen-render", shape);
+    nkBench_Report("traversal", name, tree->nodes, nkBench_Now() - start, tree->nodes);
+
+    nkView_ThawSubtree(root);
+}
+
+/* nkView_PlaceView per child against nkView_PlaceViews in batches. The
+   width changes before every pass so each one moves every frame, and the
+   two take turns going first. */
+static void RunPlacement(TraversalTree_t *tree, size_t count)
+{
+    nkView_t **views = malloc(count * sizeof(nkView_t *));
+    nkRect_t *frames = malloc(count * sizeof(nkRect_t));
+
+    if (views == NULL || frames == NULL)
+    {
+        free(views);
+        free(frames);
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        views[i] = &tree->leaves[i];
+        views[i]->horizontalAlignment = (nkHorizontalAlignment_t)(i % 4);
+        views[i]->verticalAlignment = (nkVerticalAlignment_t)((i / 4) % 4);
+        frames[i] = (nkRect_t){0.0f, (float)i * 10.0f, 800.0f, 10.0f};
+    }
+
+    uint64_t best[2] = {UINT64_MAX, UINT64_MAX}; /* single, batch */
+    float width = 800.0f;
+
+    for (int pass = 0; pass < 2 * PLACE_ROUNDS; pass++)
+    {
+        /* single, batch, batch, single, ... */
+        int batch = (pass % 4 == 1 || pass % 4 == 2);
+
+        width = (width == 800.0f) ? 1024.0f : 800.0f;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            frames[i].width = width;
+        }
+
+        uint64_t start = nkBench_Now();
+
+        if (batch)
+        {
+            nkView_PlaceViews(views, frames, count);
+        }
+        else
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                nkView_PlaceView(views[i], frames[i]);
+            }
+        }
+
+        uint64_t elapsed = nkBench_Now() - start;
+
+        if (elapsed < best[batch])
+        {
+            best[batch] = elapsed;
+        }
+    }
+
+    nkBench_Report("traversal", "flat/place-single", tree->nodes, best[0], count);
+    nkBench_Report("traversal", "flat/place-batch", tree->nodes, best[1], count);
+
+    free(views);
+    free(frames);
+}
+
+/* nkView_PlaceViews gives nkView_PlaceView's frames bit for bit, signed
+   zeros and NaNs included, for every alignment against awkward sizes */
+static void CheckPlacement(void)
+{
+    static nkView_t single[CHECK_BATCH];
+    static nkView_t batch[CHECK_BATCH];
+    nkView_t *batchViews[CHECK_BATCH];
+    nkRect_t frames[CHECK_BATCH];
+
+    const float values[] = {0.0f, -0.0f, NAN, 5.0f, 40.0f, -3.0f};
+    const size_t valueCount = sizeof(values) / sizeof(values[0]);
+    const size_t cases = 16 * valueCount * valueCount * valueCount;
+    bool matches = true;
+
+    for (size_t first = 0; first < cases; first += CHECK_BATCH)
+    {
+        size_t count = (cases - first < CHECK_BATCH) ? cases - first : CHECK_BATCH;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t c = first + i;
+            float request = values[(c / 16) % valueCount];
+            float size = values[(c / 16 / valueCount) % valueCount];
+            float margin = values[(c / 16 / valueCount / valueCount) % valueCount];
+
+            nkView_Create(&single[i], "Single");
+            single[i].horizontalAlignment = (nkHorizontalAlignment_t)(c % 4);
+            single[i].verticalAlignment = (nkVerticalAlignment_t)((c / 4) % 4);
+            single[i].sizeRequest = (nkSize_t){request, request};
+            single[i].margin = (nkThickness_t){margin, margin, 1.0f, 1.0f};
+            batch[i] = single[i];
+            batchViews[i] = &batch[i];
+            frames[i] = (nkRect_t){10.0f, 10.0f, size, size};
+
+            nkView_PlaceView(&single[i], frames[i]);
+        }
+
+        nkView_PlaceViews(batchViews, frames, count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            matches = matches && memcmp(&single[i].frame, &batch[i].frame, sizeof(nkRect_t)) == 0;
+            nkView_Destroy(&single[i]);
+            nkView_Destroy(&batch[i]);
+        }
+    }
+
+    nkBench_Check("traversal", "place-batch-matches-single", matches);
+}
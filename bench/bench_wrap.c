@@ -0,0 +1,188 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  bench_wrap.c
+** Module       :  bench
+** Author       :  SH
+** Created      :  2025-09-15 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Wrap view reflow with 50k children. Resizing
+**                 one child reflows a few lines, moving one
+**                 re-indexes the children it passes over, and a
+**                 change of width reflows them all.
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "bench.h"
+
+#include <nanoview.h>
+#include <views/views.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define CHILD_COUNT 50000
+#define WINDOW_WIDTH 1280.0f
+#define WINDOW_HEIGHT 800.0f
+#define RESIZE_COUNT 1000
+#define WIDTH_COUNT 20
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    nkView_t root;          /* window sized and clipped, the wrap scrolls inside it */
+    nkWrapView_t wrap;
+    nkView_t children[CHILD_COUNT];
+    nkSize_t sizes[CHILD_COUNT];
+} WrapTree_t;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static nkSize_t MeasureViewport(nkView_t *view, nkSize_t available, nkDrawContext_t *context);
+static void ArrangeViewport(nkView_t *view, nkDrawContext_t *context);
+static nkSize_t MeasureChild(nkView_t *view, nkSize_t available, nkDrawContext_t *context);
+static uint32_t Random(uint32_t *state);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkBench_Wrap(void)
+{
+    WrapTree_t *tree = calloc(1, sizeof(WrapTree_t));
+
+    if (tree == NULL)
+    {
+        return;
+    }
+
+    nkView_t *root = &tree->root;
+    nkDrawContext_t *context = (nkDrawContext_t *)tree; /* never dereferenced by the stub */
+    uint32_t seed = 1;
+    uint64_t start;
+
+    nkView_Create(root, "Viewport");
+    root->measureSizeCallback = MeasureViewport;
+    root->arrangeCallback = ArrangeViewport;
+    root->clipToBounds = true;
+    nkWrapView_Create(&tree->wrap);
+    nkView_AddChildView(root, &tree->wrap.view);
+
+    start = nkBench_Now();
+
+    for (size_t i = 0; i < CHILD_COUNT; i++)
+    {
+        nkView_t *child = &tree->children[i];
+
+        nkView_Create(child, "Node");
+        child->backgroundColor = NK_COLOR_BLACK;
+        child->measureSizeCallback = MeasureChild;
+        child->data = &tree->sizes[i];
+        tree->sizes[i] = (nkSize_t){20.0f + (float)(Random(&seed) % 60), 16.0f + (float)(Random(&seed) % 16)};
+
+        nkView_AddChildView(&tree->wrap.view, child);
+    }
+
+    nkView_LayoutTree(root, (nkSize_t){WINDOW_WIDTH, WINDOW_HEIGHT}, context);
+    nkBench_Report("wrap", "build+layout", CHILD_COUNT + 2, nkBench_Now() - start, CHILD_COUNT);
+
+    /* one child changes width per layout, anywhere in the list */
+    start = nkBench_Now();
+
+    for (int i = 0; i < RESIZE_COUNT; i++)
+    {
+        size_t index = Random(&seed) % CHILD_COUNT;
+
+        tree->sizes[index].width = 20.0f + (float)(Random(&seed) % 60);
+        nkView_InvalidateMeasure(&tree->children[index]);
+        nkView_LayoutTree(root, (nkSize_t){WINDOW_WIDTH, WINDOW_HEIGHT}, context);
+    }
+
+    nkBench_Report("wrap", "resize-child", CHILD_COUNT + 2, nkBench_Now() - start, RESIZE_COUNT);
+
+    /* every line moves */
+    start = nkBench_Now();
+
+    for (int i = 0; i < WIDTH_COUNT; i++)
+    {
+        nkView_LayoutTree(root, (nkSize_t){WINDOW_WIDTH - (float)(i % 2) * 100.0f, WINDOW_HEIGHT}, context);
+    }
+
+    nkBench_Report("wrap", "resize-window", CHILD_COUNT + 2, nkBench_Now() - start, WIDTH_COUNT);
+
+    /* one child moves elsewhere in the list per layout */
+    start = nkBench_Now();
+
+    for (int i = 0; i < RESIZE_COUNT; i++)
+    {
+        nkView_t *child = &tree->children[Random(&seed) % CHILD_COUNT];
+        nkView_t *before = &tree->children[Random(&seed) % CHILD_COUNT];
+
+        if (child != before)
+        {
+            nkView_RemoveChildView(&tree->wrap.view, child);
+            nkView_InsertView(&tree->wrap.view, child, before);
+        }
+
+        nkView_LayoutTree(root, (nkSize_t){WINDOW_WIDTH, WINDOW_HEIGHT}, context);
+    }
+
+    nkBench_Report("wrap", "move-child", CHILD_COUNT + 2, nkBench_Now() - start, RESIZE_COUNT);
+
+    start = nkBench_Now();
+
+    for (int i = 0; i < RESIZE_COUNT; i++)
+    {
+        nkView_RenderTree(root, context);
+    }
+
+    nkBench_Report("wrap", "render", CHILD_COUNT + 2, nkBench_Now() - start, RESIZE_COUNT);
+    printf("wrap         %zu lines\n", tree->wrap.lineCount);
+
+    nkWrapView_Destroy(&tree->wrap);
+    free(tree);
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static nkSize_t MeasureViewport(nkView_t *view, nkSize_t available, nkDrawContext_t *context)
+{
+    nkView_Measure(view->child, (nkSize_t){available.width, INFINITY}, context);
+
+    return available;
+}
+
+static void ArrangeViewport(nkView_t *view, nkDrawContext_t *context)
+{
+    nkRect_t frame = view->frame;
+
+    nkView_PlaceView(view->child, (nkRect_t){frame.x, frame.y, frame.width, view->child->sizeRequest.height});
+}
+
+static nkSize_t MeasureChild(nkView_t *view, nkSize_t available, nkDrawContext_t *context)
+{
+    return *(nkSize_t *)view->data;
+}
+
+static uint32_t Random(uint32_t *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return (*state >> 16) & 0x7fff;
+}
@@ -0,0 +1,114 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkdraw_stub.c
+** Module       :  bench
+** Author       :  SH
+** Created      :  2025-09-06 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Stand-in NanoDraw backend for benchmarks. Draw
+**                 calls are only counted and text metrics are fixed,
+**                 so results only reflect NanoView's own cost.
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "bench.h"
+
+#include <nanodraw.h>
+
+#include <string.h>
+#include <stdatomic.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define STUB_GLYPH_WIDTH 7.0f
+#define STUB_LINE_HEIGHT 14.0f
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static nkBenchDrawCounts_t counts;
+static atomic_uint_fast64_t measures; /* text is measured from parallel layout too */
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+nkColor_t nkColor_FromHexRGB(uint32_t hex)
+{
+    return (nkColor_t){
+        (float)((hex >> 16) & 0xFF) / 255.0f,
+        (float)((hex >> 8) & 0xFF) / 255.0f,
+        (float)(hex & 0xFF) / 255.0f,
+        1.0f
+    };
+}
+
+nkColor_t nkColor_Lighten(nkColor_t color, float amount)
+{
+    color.r += (1.0f - color.r) * amount;
+    color.g += (1.0f - color.g) * amount;
+    color.b += (1.0f - color.b) * amount;
+    return color;
+}
+
+nkColor_t nkColor_Darken(nkColor_t color, float amount)
+{
+    color.r *= 1.0f - amount;
+    color.g *= 1.0f - amount;
+    color.b *= 1.0f - amount;
+    return color;
+}
+
+nkThickness_t nkThickness_FromConstant(float value)
+{
+    return (nkThickness_t){value, value, value, value};
+}
+
+bool nkRect_ContainsPoint(nkRect_t rect, nkPoint_t point)
+{
+    return point.x >= rect.x && point.x <= rect.x + rect.width
+        && point.y >= rect.y && point.y <= rect.y + rect.height;
+}
+
+void nkDraw_SaveContext(nkDrawContext_t *context) { counts.saves++; }
+void nkDraw_RestoreContext(nkDrawContext_t *context) { counts.restores++; }
+void nkDraw_SetClipRect(nkDrawContext_t *context, nkRect_t rect) { counts.clips++; }
+void nkDraw_SetColor(nkDrawContext_t *context, nkColor_t color) { counts.states++; }
+void nkDraw_SetStrokeWidth(nkDrawContext_t *context, float width) { counts.states++; }
+void nkDraw_Rect(nkDrawContext_t *context, float x, float y, float width, float height) { counts.shapes++; }
+void nkDraw_RoundedRect(nkDrawContext_t *context, float x, float y, float width, float height, float radius) { counts.shapes++; }
+void nkDraw_RoundedRectPath(nkDrawContext_t *context, float x, float y, float width, float height, float radius) { counts.shapes++; }
+void nkDraw_Text(nkDrawContext_t *context, nkFont_t *font, const char *text, float x, float y) { counts.texts++; }
+
+void nkDraw_SetColorGradient(nkDrawContext_t *context, nkColor_t start, nkColor_t end, float angle, float x, float y, float width, float height) { counts.states++; }
+void nkDraw_SetStrokeColorGradient(nkDrawContext_t *context, nkColor_t start, nkColor_t end, float angle, float x, float y, float width, float height) { counts.states++; }
+
+nkRect_t nkDraw_MeasureText(nkDrawContext_t *context, nkFont_t *font, const char *text)
+{
+    atomic_fetch_add_explicit(&measures, 1, memory_order_relaxed);
+
+    return (nkRect_t){0, 0, STUB_GLYPH_WIDTH * (float)strlen(text), STUB_LINE_HEIGHT};
+}
+
+nkBenchDrawCounts_t nkBench_DrawCounts(void)
+{
+    nkBenchDrawCounts_t result = counts;
+    result.measures = atomic_load_explicit(&measures, memory_order_relaxed);
+
+    return result;
+}
+
+void nkBench_ResetDrawCounts(void)
+{
+    memset(&counts, 0, sizeof(counts));
+    atomic_store_explicit(&measures, 0, memory_order_relaxed);
+}
@@ -17,28 +17,201 @@
 
 #include <nanoview.h>
 #include <nanodraw.h>
+#include "nkhitindex.h"
+
+#ifdef NANOVIEW_PARALLEL
+#include "nkthreadpool.h"
+#endif
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <float.h>
+
+/* the scalar maths must round like the SSE lanes, not at x87 precision */
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && FLT_EVAL_METHOD == 0
+#define NANOVIEW_SSE
+#include <emmintrin.h>
+#endif
 
 /***************************************************************
 ** MARK: CONSTANTS & MACROS
 ***************************************************************/
 
+#ifdef NANOVIEW_PROFILE
+#define PROFILE_BEGIN() nkProfileScope_t profileScope = nkProfiler_Begin()
+#define PROFILE_END(view, phase) nkProfiler_End((view), (phase), profileScope)
+#else
+#define PROFILE_BEGIN()
+#define PROFILE_END(view, phase)
+#endif
+
+/* bounds of a subtree that culls its own children, large enough to overlap any clip */
+#define UNBOUNDED_RECT ((nkRect_t){-FLT_MAX / 4.0f, -FLT_MAX / 4.0f, FLT_MAX / 2.0f, FLT_MAX / 2.0f})
+
+#define MAX_OCCLUDERS 16 /* the largest opaque views are kept */
+#define MIN_OCCLUDER_SHARE (1.0f / 64.0f) /* of the pass's clip, smaller views hide too little to test against */
+
+#define PARALLEL_MAX_FORK_DEPTH 4 /* deeper subtrees are measured serially by their task */
+#define PARALLEL_MAX_RANGES 64
+
 /***************************************************************
 ** MARK: TYPEDEFS
 ***************************************************************/
 
+/* the part of the window an opaque view covers */
+typedef struct
+{
+    nkRect_t rect;
+    float area;
+} Occluder_t;
+
+/* where a hit test from root would find view again, see nkView_ProcessPointerMovement */
+typedef struct
+{
+    nkView_t *root;
+    nkView_t *view; /* NULL if there is no memo */
+    uint32_t version; /* hitVersion it was found at */
+    float left, top, right, bottom; /* edges in root's frame coords, as the hit test computes them, empty if no region was safe */
+} HitMemo_t;
+
+#ifdef NANOVIEW_PARALLEL
+
+/* a run of the parent's queued children measured by one task */
+typedef struct
+{
+    nkView_t **children;
+    size_t count;
+    size_t depth;
+    nkDrawContext_t *context;
+    const nkTextMetrics_t *textMetrics;
+    size_t resized; /* out: children whose sizeRequest changed */
+    uint64_t layoutCallbacks; /* out: measure callbacks run */
+    bool needsArrange; /* out: a child needs arranging */
+} MeasureRange_t;
+
+#endif
+
 /***************************************************************
 ** MARK: STATIC VARIABLES
 ***************************************************************/
 
+/* set for the duration of a headless layout on this thread */
+static _Thread_local const nkTextMetrics_t *textMetrics = NULL;
+
+/* see nkView_Stats */
+static _Thread_local nkViewStats_t stats;
+
+/* every render pass draws through this, see nkView_SetDrawBatching */
+static nkDrawBatch_t drawBatch;
+static nkDisplayList_t scratchList; /* records views without retained drawing while batching */
+
+/* children found by RenderIndexedChildren, each nested call's above its caller's */
+static nkHitIndexMatch_t *renderMatches = NULL;
+static size_t renderMatchCount = 0;
+static size_t renderMatchCapacity = 0;
+
+/* see nkView_SetOcclusionCulling */
+static bool occlusionCulling = false;
+static uint32_t renderPassCount = 0; /* stamps occludedPass */
+static Occluder_t occluders[MAX_OCCLUDERS]; /* drawn after the views still to be walked, largest first */
+static size_t occluderCount = 0;
+static float minOccluderArea = 0.0f;
+
+/* set while ArrangeDirtyViews runs, whose walk reaches the children it places */
+static bool arranging = false;
+
+/* see nkView_ProcessPointerMovement */
+static HitMemo_t hitMemo;
+static uint32_t hitVersion = 0; /* bumped by frame changes, child offsets and tree edits */
+
+#ifdef NANOVIEW_PARALLEL
+static bool parallelLayout = false;
+static bool parallelMeasureActive = false; /* a parallel pass is running, serialize unsafe callbacks */
+#endif
+
 /***************************************************************
 ** MARK: STATIC FUNCTION DEFS
 ***************************************************************/
 
+static bool RectEquals(nkRect_t a, nkRect_t b);
+static bool RectIsEmpty(nkRect_t rect);
+static bool RectsOverlap(nkRect_t a, nkRect_t b);
+static bool RectContains(nkRect_t outer, nkRect_t inner);
+static nkRect_t RectIntersection(nkRect_t a, nkRect_t b);
+static nkRect_t RectUnion(nkRect_t a, nkRect_t b);
+static nkRect_t Translate(nkRect_t rect, nkPoint_t offset);
+static void MarkFrameChange(nkView_t *view, nkRect_t previousFrame);
+static float FitSize(float request, float available);
+
+#ifdef NANOVIEW_SSE
+static void PlaceViews4(nkView_t **views, const nkRect_t *frames);
+static void PlaceAxis4(__m128 framePos, __m128 frameSize, __m128 request, __m128 leading, __m128 trailing, __m128i alignment, __m128 *pos, __m128 *size);
+#endif
+static bool SizeEquals(nkSize_t a, nkSize_t b);
+static bool MeasureCurrent(const nkView_t *view);
+
+static void PropagateDirtyFlags(nkView_t *view);
+static void CountListingViews(nkView_t *parent, const nkView_t *subtree, bool added);
+static void NotifyChildList(nkView_t *parent, nkView_t *child, bool added);
+static void RevealListedChildren(nkView_t *view);
+static void PropagateRedrawFlags(nkView_t *view);
+static void DamageFrame(nkView_t *view, nkRect_t previousFrame);
+static void DamageSubtree(nkView_t *view, nkView_t *subtree);
+static nkRect_t StaleSubtreeBounds(nkView_t *view);
+static void InvalidateSubtreeBounds(nkView_t *view);
+static nkRect_t SubtreeBounds(nkView_t *view);
+static bool ChildrenSpill(nkView_t *view);
+static void CollectDamage(nkView_t *root, nkDamageRegion_t *damage);
+static bool CollectSubtreeDamage(nkView_t *root, size_t depth, nkDamageRegion_t *damage);
+
+static void QueueMeasure(nkView_t *view);
+static void UnqueueMeasure(nkView_t *view);
+static nkView_t *NextQueuedMeasure(nkView_t *parent);
+static nkView_t *DeepestDirtyMeasureView(nkView_t *view);
+static void MeasureDirtyViews(nkView_t *root, nkSize_t constraint, nkDrawContext_t *context);
+static void MeasurePass(nkView_t *root, nkSize_t constraint, nkDrawContext_t *context);
+
+static void BeginMeasureCallback(nkView_t *view);
+static void EndMeasureCallback(nkView_t *view);
+
+#ifdef NANOVIEW_PARALLEL
+static size_t CountQueuedMeasures(nkView_t *parent, size_t limit);
+static void MeasureRangeTask(void *argument);
+static void MeasureDirtyViewsParallel(nkView_t *root, nkSize_t constraint, nkDrawContext_t *context, size_t depth);
+#endif
+
+static nkView_t *NextDirtyArrangeSibling(nkView_t *view);
+static void ArrangeDirtyViews(nkView_t *root, nkDrawContext_t *context);
+static void ArrangeListedChildren(nkView_t *view, nkDrawContext_t *context);
+
+static void RenderPass(nkView_t *root, const nkRect_t *damage, nkDrawContext_t *context);
+static void RenderSubtree(nkView_t *root, nkView_t **previous, nkRect_t clip, nkPoint_t translation, nkDrawContext_t *context);
+static bool RenderIndexedChildren(nkView_t *view, nkView_t **previous, nkDrawContext_t *context);
+static void RenderView(nkView_t *view, nkRect_t frame, nkView_t **previous, nkRect_t clip, nkPoint_t translation, nkDrawContext_t *context);
+static void FindOccluders(nkView_t *root, nkRect_t clip, nkPoint_t translation);
+static bool EnterOccludable(nkView_t *view, nkRect_t clip, nkPoint_t translation);
+static void AddOccluder(nkView_t *view, nkRect_t clip, nkPoint_t translation);
+static void RestoreDrawState(nkView_t *from, nkView_t *to);
+static void DrawRecorded(nkView_t *view, bool translated, nkDrawContext_t *context);
+static nkView_t *HitTestFrozen(nkFrozenSubtree_t *frozen, float x, float y);
+static nkHitIndex_t *PrepareHitIndex(nkView_t *view);
+static nkView_t *HitTestFromHotView(nkView_t *root, nkView_t *hotView, float x, float y);
+static bool FollowHitPath(nkView_t *root, nkView_t *view, float *x, float *y, nkView_t **hit);
+static bool HitTestAbove(nkView_t *parent, nkView_t *child, float x, float y, nkView_t **hit);
+static bool InFrame(nkView_t *view, float x, float y);
+static bool HasHitMemo(nkView_t *root, nkView_t *view);
+static bool InHitMemo(nkView_t *root, nkView_t *view, float x, float y);
+static void BuildHitMemo(nkView_t *root, nkView_t *view);
+static bool ChildrenOverlap(nkView_t *parent, nkView_t *above, float left, float top, float right, float bottom);
+static void HitFrameChanged(nkView_t *view);
+static nkPoint_t ToFrameCoords(nkView_t *view, float x, float y);
+
+static nkView_t *FrozenAncestor(nkView_t *view);
+static void ThawEnclosing(nkView_t *view);
+static void SyncFrozen(nkFrozenSubtree_t *frozen);
+
 /***************************************************************
 ** MARK: PUBLIC FUNCTIONS
 ***************************************************************/
@@ -56,6 +229,11 @@ bool nkView_Create(nkView_t *view, const char *name)
     view->sibling = NULL;
     view->prevSibling = NULL;
     view->child = NULL;
+    view->lastChild = NULL;
+    view->childCount = 0;
+    view->structureVersion = 0;
+    view->containerIndex = 0;
+    view->listingDescendants = 0;
 
     view->horizontalAlignment = ALIGNMENT_STRETCH;
     view->verticalAlignment = ALIGNMENT_FILL;
@@ -64,21 +242,72 @@ bool nkView_Create(nkView_t *view, const char *name)
     view->gridLocation = (nkGridLocation_t){0, 0, 1, 1};
     view->canvasRect = (nkRect_t){0, 0, 0, 0};
 
+    view->measureSizeCallback = NULL;
     view->measureCallback = NULL;
     view->arrangeCallback = NULL;
     view->drawCallback = NULL;
+    view->recordCallback = NULL;
     view->destroyCallback = NULL;
+    view->queryChildrenCallback = NULL;
+    view->childChangedCallback = NULL;
+    view->childListCallback = NULL;
     view->pointerHoverCallback = NULL;
     view->pointerMovementCallback = NULL;
     view->pointerActionCallback = NULL;
     view->scrollCallback = NULL;
 
     view->backgroundColor = NK_COLOR_TRANSPARENT;
+    view->opaque = false;
 
     view->data = NULL;
     view->dataSize = 0; /* size of the data in bytes */
 
     view->clipToBounds = false;
+    view->childOffset = (nkPoint_t){0, 0};
+    view->measureThreadSafe = false;
+
+    /* a new view has never been laid out */
+    view->needsMeasure = true;
+    view->needsArrange = true;
+    view->childNeedsMeasure = false;
+    view->childNeedsArrange = false;
+
+    view->measureQueue = NULL;
+    view->nextQueued = NULL;
+    view->prevQueued = NULL;
+    view->queued = false;
+
+    view->contentVersion = 0;
+    view->measureCache = (nkMeasureCache_t){{INFINITY, INFINITY}, {0, 0}, 0, NULL, 0, false};
+
+    /* nor drawn */
+    view->needsRedraw = true;
+    view->childNeedsRedraw = false;
+    view->staleBounds = (nkRect_t){0, 0, 0, 0};
+
+    view->retainDrawing = false;
+    view->visualVersion = 0;
+    view->displayList = NULL;
+
+    view->subtreeBounds = (nkRect_t){0, 0, 0, 0};
+    view->subtreeBoundsValid = false;
+    view->childrenSpill = false;
+    view->childrenBounds = (nkRect_t){0.0f, 0.0f, 0.0f, 0.0f};
+    view->childrenSpillValid = false;
+    view->childrenSpillVersion = 0;
+    view->occludedPass = 0;
+    view->childClip = (nkRect_t){0, 0, 0, 0};
+    view->childTranslation = (nkPoint_t){0, 0};
+
+    view->drawChangesState = false;
+    view->drawStateSaved = false;
+
+    view->frozen = NULL;
+    view->hitIndex = NULL;
+
+#ifdef NANOVIEW_PROFILE
+    memset(&view->profile, 0, sizeof(view->profile));
+#endif
 
     return view;
 }
@@ -89,6 +318,27 @@ void nkView_Destroy(nkView_t *view)
     {
         return;
     }
+
+    nkView_ThawSubtree(view);
+
+    if (view->displayList != NULL)
+    {
+        nkDisplayList_Destroy(view->displayList);
+        free(view->displayList);
+        view->displayList = NULL;
+    }
+
+    if (hitMemo.view == view || hitMemo.root == view)
+    {
+        hitMemo.view = NULL;
+    }
+
+    if (view->hitIndex != NULL)
+    {
+        nkHitIndex_Destroy(view->hitIndex);
+        free(view->hitIndex);
+        view->hitIndex = NULL;
+    }
     
     return;
 }
@@ -100,171 +350,343 @@ void nkView_LayoutTree(nkView_t *root, nkSize_t size, nkDrawContext_t *context)
         return;
     }
 
-    nkView_t *view = root;
+    /* MEASURE PASS */
 
-    root->frame = (nkRect_t){0, 0, size.width, size.height};
+    MeasurePass(root, size, context);
 
+    /* ARRANGE PASS */
 
-    /* MEASURE PASS */
+    nkRect_t frame = {0, 0, size.width, size.height};
 
-    view = nkView_DeepestViewInTree(root);
+    /* clamp root to size */
+
+    if (root->sizeRequest.width > frame.width)
+    {
+        frame.width = root->sizeRequest.width;
+    }
     
-    /* measure views in a bottom-up traversal */
+    if (root->sizeRequest.height > frame.height)
+    {
+        frame.height = root->sizeRequest.height;
+    }
 
-    while (view)
+    if (!RectEquals(root->frame, frame))
     {
-        if (view->measureCallback)
-        {
-            view->measureCallback(view, context);
-        }
+        DamageFrame(root, root->frame);
+        root->frame = frame;
+        root->needsArrange = true;
+        HitFrameChanged(root);
+    }
 
-        view = nkView_PreviousViewInTree(view);
+    ArrangeDirtyViews(root, context);
+}
+
+void nkView_LayoutSubtree(nkView_t *root, nkDrawContext_t *context)
+{
+    if (root == NULL)
+    {
+        return;
     }
 
-    /* ARRANGE PASS */
+    /* MEASURE PASS */
+
+    MeasurePass(root, root->measureCache.constraint, context);
 
-    view = root;
+    /* ARRANGE PASS */
 
     /* clamp root to size */
 
+    nkRect_t previousFrame = root->frame;
+
     if (root->sizeRequest.width > root->frame.width)
     {
         root->frame.width = root->sizeRequest.width;
+        root->needsArrange = true;
     }
     
     if (root->sizeRequest.height > root->frame.height)
     {
         root->frame.height = root->sizeRequest.height;
+        root->needsArrange = true;
     }
 
-    /* arrange views in top-down */
-    while (view)
+    if (!RectEquals(previousFrame, root->frame))
     {
+        DamageFrame(root, previousFrame);
+    }
 
-        if (view->arrangeCallback)
-        {
-            view->arrangeCallback(view, context);
-        }
+    ArrangeDirtyViews(root, context);
 
-        view = nkView_NextViewInTree(view);
+    /* an enclosing frozen subtree didn't see these frames change */
+    nkView_t *frozenRoot = FrozenAncestor(root->parent);
+
+    if (frozenRoot != NULL)
+    {
+        frozenRoot->frozen->synced = false;
     }
+}
+
+void nkView_LayoutTreeHeadless(nkView_t *root, nkSize_t size, const nkTextMetrics_t *metrics)
+{
+    const nkTextMetrics_t *previousMetrics = textMetrics;
+    textMetrics = metrics;
+
+    nkView_LayoutTree(root, size, NULL);
 
+    textMetrics = previousMetrics;
 }
 
-void nkView_LayoutSubtree(nkView_t *root, nkDrawContext_t *context)
+nkRect_t nkView_MeasureText(nkDrawContext_t *context, nkFont_t *font, const char *text)
 {
-    if (root == NULL)
+    if (textMetrics != NULL)
     {
-        return;
+        return textMetrics->measureText(textMetrics, font, text);
     }
 
-    nkView_t *view = root;
+    return nkDraw_MeasureText(context, font, text);
+}
 
-    /* MEASURE PASS */
+bool nkView_SetParallelLayout(size_t threadCount)
+{
+#ifdef NANOVIEW_PARALLEL
+    if (threadCount < 2)
+    {
+        nkThreadPool_Stop();
+        parallelLayout = false;
 
-    view = nkView_DeepestViewInTree(root);
-    
-    /* measure views in a bottom-up traversal */
+        return true;
+    }
 
-    while (view)
-    {
-        if (view->measureCallback)
-        {
-            view->measureCallback(view, context);
-        }
+    parallelLayout = nkThreadPool_Start(threadCount);
+
+    return parallelLayout;
+#else
+    return threadCount < 2;
+#endif
+}
 
-        view = nkView_PreviousViewInTree(view);
+void nkView_InvalidateMeasure(nkView_t *view)
+{
+    if (view == NULL)
+    {
+        return;
     }
 
-    /* ARRANGE PASS */
+    view->needsMeasure = true;
+    view->needsArrange = true;
+    view->contentVersion++;
+    view->visualVersion++; /* content drawn from may have changed too */
 
-    view = root;
+    PropagateDirtyFlags(view);
+}
 
-    /* clamp root to size */
+void nkView_InvalidateArrange(nkView_t *view)
+{
+    if (view == NULL)
+    {
+        return;
+    }
 
-    if (root->sizeRequest.width > root->frame.width)
+    view->needsArrange = true;
+
+    PropagateDirtyFlags(view);
+}
+
+bool nkView_NeedsLayout(nkView_t *root)
+{
+    if (root == NULL)
     {
-        root->frame.width = root->sizeRequest.width;
+        return false;
     }
-    
-    if (root->sizeRequest.height > root->frame.height)
+
+    return root->needsMeasure || root->needsArrange || root->childNeedsMeasure || root->childNeedsArrange;
+}
+
+void nkView_InvalidateVisual(nkView_t *view)
+{
+    if (view == NULL)
     {
-        root->frame.height = root->sizeRequest.height;
+        return;
     }
 
-    /* arrange views in top-down */
-    while (view)
+    view->needsRedraw = true;
+    view->visualVersion++;
+
+    PropagateRedrawFlags(view);
+}
+
+void nkView_SetBackgroundColor(nkView_t *view, nkColor_t color)
+{
+    if (view == NULL)
     {
+        return;
+    }
 
-        if (view->arrangeCallback)
-        {
-            view->arrangeCallback(view, context);
-        }
+    nkColor_t previous = view->backgroundColor;
 
-        view = nkView_NextViewInTree(view);
+    if (previous.r != color.r || previous.g != color.g || previous.b != color.b || previous.a != color.a)
+    {
+        view->backgroundColor = color;
+        nkView_InvalidateVisual(view);
     }
 }
 
-void nkView_RenderTree(nkView_t *root, nkDrawContext_t *drawContext)
+void nkView_SetClipToBounds(nkView_t *view, bool clipToBounds)
 {
-    if (root == NULL || drawContext == NULL)
+    if (view == NULL || view->clipToBounds == clipToBounds)
     {
         return;
     }
 
-    int prevDepth = -1;
-    nkView_t *view = root;
+    /* what the subtree showed or will show outside the view */
+    DamageSubtree(view, view);
 
-    /* render views in a top-down traversal (this is actually bottom up in visual tree 
-       as child views appear on top) */
+    view->clipToBounds = clipToBounds;
+}
 
-    while (view)
+void nkView_SetChildOffset(nkView_t *view, nkPoint_t offset)
+{
+    if (view == NULL || (view->childOffset.x == offset.x && view->childOffset.y == offset.y))
     {
-        int currentDepth = (int)nkView_GetDepthInTree(view);
+        return;
+    }
 
-        if (currentDepth <= prevDepth)
+    /* a clipping view's children only show within its frame, so repainting
+       that covers them wherever they were; otherwise the subtree is damaged
+       where it was and where it goes */
+    if (view->clipToBounds)
+    {
+        nkView_InvalidateVisual(view);
+    }
+    else
+    {
+        for (nkView_t *child = view->child; child != NULL; child = child->sibling)
         {
-            /* restore context if we are going up in the tree */
-            int depthDiff = prevDepth - currentDepth + 1;
-            for (int i = 0; i < depthDiff; i++)
-            {
-                nkDraw_RestoreContext(drawContext);
-            }
+            DamageSubtree(view, child);
         }
+    }
 
-        /* always save context */
-        nkDraw_SaveContext(drawContext);
+    view->childOffset = offset;
+    hitVersion++;
 
-        if (view->clipToBounds)
+    if (!view->clipToBounds)
+    {
+        for (nkView_t *child = view->child; child != NULL; child = child->sibling)
         {
-            nkDraw_SetClipRect(drawContext, view->frame);
+            DamageSubtree(view, child);
         }
+    }
 
-        if (view->backgroundColor.a > 0.001f)
-        {
-            nkDraw_SetColor(drawContext, view->backgroundColor);
-            nkDraw_Rect(drawContext, view->frame.x, view->frame.y, view->frame.width, view->frame.height);
-        }
+    InvalidateSubtreeBounds(view);
 
-        if (view->drawCallback)
-        {
-            view->drawCallback(view, drawContext);
-        }
+    if (view->queryChildrenCallback || view->listingDescendants > 0)
+    {
+        RevealListedChildren(view);
+    }
 
-        prevDepth = currentDepth;
+    nkView_t *frozenRoot = FrozenAncestor(view);
 
-        view = nkView_NextViewInTree(view);
+    if (frozenRoot != NULL)
+    {
+        frozenRoot->frozen->synced = false;
     }
+}
+
+nkPoint_t nkView_WindowOffset(nkView_t *view)
+{
+    nkPoint_t offset = {0, 0};
 
-    if (prevDepth > -1)
+    for (nkView_t *ancestor = (view != NULL) ? view->parent : NULL; ancestor != NULL; ancestor = ancestor->parent)
     {
-        int finalPopCount = prevDepth + 1;
-        for (int i = 0; i < finalPopCount; i++)
-        {
-            nkDraw_RestoreContext(drawContext);
-        }
+        offset.x += ancestor->childOffset.x;
+        offset.y += ancestor->childOffset.y;
+    }
+
+    return offset;
+}
+
+void nkView_RenderTree(nkView_t *root, nkDrawContext_t *drawContext)
+{
+    if (root == NULL || drawContext == NULL)
+    {
+        return;
+    }
+
+    RenderPass(root, NULL, drawContext);
+}
+
+void nkView_CollectDamage(nkView_t *root, nkDamageRegion_t *damage)
+{
+    if (root == NULL || damage == NULL)
+    {
+        return;
+    }
+
+    CollectDamage(root, damage);
+}
+
+bool nkView_NeedsRender(nkView_t *root)
+{
+    if (root == NULL)
+    {
+        return false;
+    }
+
+    return root->needsRedraw || root->childNeedsRedraw || !RectIsEmpty(root->staleBounds);
+}
+
+void nkView_RenderDamage(nkView_t *root, nkDrawContext_t *drawContext, const nkDamageRegion_t *damage)
+{
+    if (root == NULL || drawContext == NULL || damage == NULL)
+    {
+        return;
+    }
+
+    /* one pass per rect, as the context clips to a single rect */
+    for (size_t i = 0; i < damage->count; i++)
+    {
+        nkRect_t clip = damage->rects[i];
+
+        nkDraw_SaveContext(drawContext);
+        nkDraw_SetClipRect(drawContext, clip);
+
+        RenderPass(root, &clip, drawContext);
+
+        nkDraw_RestoreContext(drawContext);
+
+        stats.saves++;
+        stats.drawCalls += 3;
     }
+}
+
+void nkView_SetDrawBatching(bool enabled)
+{
+    drawBatch.enabled = enabled;
+}
+
+nkDrawBatchStats_t nkView_DrawBatchStats(void)
+{
+    return drawBatch.stats;
+}
+
+void nkView_ResetDrawBatchStats(void)
+{
+    drawBatch.stats = (nkDrawBatchStats_t){0, 0};
+}
+
+void nkView_SetOcclusionCulling(bool enabled)
+{
+    occlusionCulling = enabled;
+}
 
+nkViewStats_t nkView_Stats(void)
+{
+    return stats;
+}
+
+void nkView_ResetStats(void)
+{
+    stats = (nkViewStats_t){0};
 }
 
 void nkView_ProcessPointerMovement(nkView_t *root, float x, float y, nkView_t **hotView, nkView_t *activeView, nkPointerAction_t activeAction)
@@ -274,7 +696,35 @@ void nkView_ProcessPointerMovement(nkView_t *root, float x, float y, nkView_t **
         return;
     }
 
-    nkView_t *newHotView = nkView_HitTest(root, x, y);
+    nkView_t *newHotView;
+
+    if (activeView != NULL && activeView->capturePointerAction)
+    {
+        /* a capturing active view has the pointer until it is released */
+        newHotView = *hotView;
+    }
+    else if (*hotView != NULL)
+    {
+        /* usually still over the same view, so start from it */
+        if (InHitMemo(root, *hotView, x, y))
+        {
+            newHotView = *hotView;
+        }
+        else
+        {
+            newHotView = HitTestFromHotView(root, *hotView, x, y);
+
+            if (newHotView == *hotView && !HasHitMemo(root, newHotView))
+            {
+                /* it stayed, so it's likely to stay again */
+                BuildHitMemo(root, newHotView);
+            }
+        }
+    }
+    else
+    {
+        newHotView = nkView_HitTest(root, x, y);
+    }
 
     /* check for change */
     if (*hotView != newHotView)
@@ -294,13 +744,15 @@ void nkView_ProcessPointerMovement(nkView_t *root, float x, float y, nkView_t **
     }
     else if (*hotView != NULL && newHotView->capturePointerMovement && (*hotView)->pointerMovementCallback)
     {
-        (*hotView)->pointerMovementCallback(*hotView, x, y);
+        nkPoint_t point = ToFrameCoords(*hotView, x, y);
+        (*hotView)->pointerMovementCallback(*hotView, point.x, point.y);
     }
 
     /* If there is an active view, process the pointer movement in it */
     if (activeView != NULL && activeView->capturePointerAction && activeView->pointerActionCallback)
     {
-        activeView->pointerActionCallback(activeView, activeAction, POINTER_EVENT_DRAG, x, y); 
+        nkPoint_t point = ToFrameCoords(activeView, x, y);
+        activeView->pointerActionCallback(activeView, activeAction, POINTER_EVENT_DRAG, point.x, point.y); 
     }
 }
 
@@ -323,7 +775,8 @@ void nkView_ProcessPointerAction(nkView_t *root, nkPointerAction_t action, nkPoi
                 /* if there is an active view, end the action */
                 if (*activeView != NULL && (*activeView)->capturePointerAction && (*activeView)->pointerActionCallback)
                 {
-                    (*activeView)->pointerActionCallback(*activeView, *activeAction, POINTER_EVENT_END, x, y);
+                    nkPoint_t point = ToFrameCoords(*activeView, x, y);
+                    (*activeView)->pointerActionCallback(*activeView, *activeAction, POINTER_EVENT_END, point.x, point.y);
                 }
 
             }
@@ -334,7 +787,8 @@ void nkView_ProcessPointerAction(nkView_t *root, nkPointerAction_t action, nkPoi
 
             if (hotView && hotView->capturePointerAction && hotView->pointerActionCallback)
             {
-                hotView->pointerActionCallback(hotView, action, POINTER_EVENT_BEGIN, x, y);
+                nkPoint_t point = ToFrameCoords(hotView, x, y);
+                hotView->pointerActionCallback(hotView, action, POINTER_EVENT_BEGIN, point.x, point.y);
             }
 
         } break;
@@ -346,7 +800,8 @@ void nkView_ProcessPointerAction(nkView_t *root, nkPointerAction_t action, nkPoi
                 /* call the action end callback */
                 if ((*activeView)->capturePointerAction && (*activeView)->pointerActionCallback)
                 {
-                    (*activeView)->pointerActionCallback(*activeView, *activeAction, POINTER_EVENT_END, x, y);
+                    nkPoint_t point = ToFrameCoords(*activeView, x, y);
+                    (*activeView)->pointerActionCallback(*activeView, *activeAction, POINTER_EVENT_END, point.x, point.y);
                 }
 
                 /* reset active view and action */
@@ -362,7 +817,8 @@ void nkView_ProcessPointerAction(nkView_t *root, nkPointerAction_t action, nkPoi
             {
                 if ((*activeView)->capturePointerAction && (*activeView)->pointerActionCallback)
                 {
-                    (*activeView)->pointerActionCallback(*activeView, *activeAction, POINTER_EVENT_CANCEL, x, y);
+                    nkPoint_t point = ToFrameCoords(*activeView, x, y);
+                    (*activeView)->pointerActionCallback(*activeView, *activeAction, POINTER_EVENT_CANCEL, point.x, point.y);
                 }
 
                 /* reset active view and action */
@@ -399,58 +855,141 @@ void nkView_AddChildView(nkView_t *parent, nkView_t *child)
         return;
     }
 
+    ThawEnclosing(parent);
+    parent->structureVersion++;
+    hitVersion++;
+
     child->parent = parent;
-    child->prevSibling = NULL;
+    child->sibling = NULL;
+    child->prevSibling = parent->lastChild; /* set the previous sibling */
 
-    if (parent->child == NULL)
+    if (parent->lastChild == NULL)
     {
         parent->child = child;
     }
     else
     {
-        nkView_t *lastChild = parent->child;
+        parent->lastChild->sibling = child;
+    }
 
-        while (lastChild->sibling != NULL)
-        {
-            lastChild = lastChild->sibling;
-        }
+    parent->lastChild = child;
+    parent->childCount++;
 
-        lastChild->sibling = child;
-        child->prevSibling = lastChild; /* set the previous sibling */
-    }
+    NotifyChildList(parent, child, true);
+    DamageSubtree(parent, child);
+    CountListingViews(parent, child, true);
+
+    PropagateDirtyFlags(child);
+    nkView_InvalidateMeasure(parent);
 }
 
-void nkView_RemoveChildView(nkView_t *parent, nkView_t *child)
+void nkView_AddChildViews(nkView_t *parent, nkView_t **children, size_t count)
 {
-    if (parent == NULL || child == NULL)
+    if (parent == NULL || children == NULL)
     {
         return;
     }
 
-    nkView_t* prev = child->prevSibling;
-    nkView_t* next = child->sibling;
+    ThawEnclosing(parent);
+    parent->structureVersion++;
+    hitVersion++;
 
-    if (prev != NULL)
-    {
-        /* The child is in the middle or end of the list */
-        prev->sibling = next;
-    }
-    else
-    {
-        /* The child is the first child of the parent */
-        parent->child = next;
-    }
+    nkView_t *lastChild = parent->lastChild;
 
-    if (next != NULL)
+    for (size_t i = 0; i < count; i++)
     {
-        /* The child was not the last in the list */
-        next->prevSibling = prev;
-    }
+        nkView_t *child = children[i];
 
-    /* Isolate the removed child */
-    child->parent = NULL;
-    child->sibling = NULL;
+        if (child == NULL)
+        {
+            continue;
+        }
+
+        child->parent = parent;
+        child->sibling = NULL;
+        child->prevSibling = lastChild;
+
+        if (lastChild == NULL)
+        {
+            parent->child = child;
+        }
+        else
+        {
+            lastChild->sibling = child;
+        }
+
+        lastChild = child;
+        parent->childCount++;
+
+        NotifyChildList(parent, child, true);
+        DamageSubtree(parent, child);
+        CountListingViews(parent, child, true);
+
+        /* mark the parent directly, it is propagated once below */
+        if (child->needsMeasure || child->childNeedsMeasure)
+        {
+            QueueMeasure(child);
+            parent->childNeedsMeasure = true;
+        }
+
+        parent->childNeedsArrange |= child->needsArrange || child->childNeedsArrange;
+    }
+
+    parent->lastChild = lastChild;
+
+    nkView_InvalidateMeasure(parent);
+}
+
+void nkView_RemoveChildView(nkView_t *parent, nkView_t *child)
+{
+    /* unlinking a view from a list it isn't in would corrupt that list */
+    if (parent == NULL || child == NULL || child->parent != parent)
+    {
+        return;
+    }
+
+    ThawEnclosing(parent);
+    parent->structureVersion++;
+    hitVersion++;
+
+    NotifyChildList(parent, child, false);
+
+    nkView_t* prev = child->prevSibling;
+    nkView_t* next = child->sibling;
+
+    if (prev != NULL)
+    {
+        /* The child is in the middle or end of the list */
+        prev->sibling = next;
+    }
+    else
+    {
+        /* The child is the first child of the parent */
+        parent->child = next;
+    }
+
+    if (next != NULL)
+    {
+        /* The child was not the last in the list */
+        next->prevSibling = prev;
+    }
+    else
+    {
+        parent->lastChild = prev;
+    }
+
+    parent->childCount--;
+
+    DamageSubtree(parent, child);
+    CountListingViews(parent, child, false);
+    UnqueueMeasure(child);
+
+    /* Isolate the removed child */
+    child->parent = NULL;
+    child->sibling = NULL;
     child->prevSibling = NULL;
+
+    nkView_InvalidateMeasure(parent);
 }
 
 void nkView_RemoveView(nkView_t *view)
@@ -484,6 +1023,10 @@ void nkView_InsertView(nkView_t *parent, nkView_t *child, nkView_t *before)
         return;
     }
 
+    ThawEnclosing(parent);
+    parent->structureVersion++;
+    hitVersion++;
+
     child->parent = parent;
 
     /* get the previous sibling */
@@ -504,7 +1047,15 @@ void nkView_InsertView(nkView_t *parent, nkView_t *child, nkView_t *before)
         /* 'before' was the first child, so we set the new child as the first */
         parent->child = child;
     }
-    
+
+    parent->childCount++;
+
+    NotifyChildList(parent, child, true);
+    DamageSubtree(parent, child);
+    CountListingViews(parent, child, true);
+
+    PropagateDirtyFlags(child);
+    nkView_InvalidateMeasure(parent);
 }
 
 void nkView_ReplaceView(nkView_t *oldView, nkView_t *newView)
@@ -516,6 +1067,13 @@ void nkView_ReplaceView(nkView_t *oldView, nkView_t *newView)
 
     nkView_t *parent = oldView->parent;
     nkView_t *prev = oldView->prevSibling;
+
+    ThawEnclosing(parent);
+    parent->structureVersion++;
+    hitVersion++;
+
+    NotifyChildList(parent, oldView, false);
+
     nkView_t *next = oldView->sibling;
 
     newView->parent = parent;
@@ -527,6 +1085,10 @@ void nkView_ReplaceView(nkView_t *oldView, nkView_t *newView)
     {
         next->prevSibling = newView;
     }
+    else
+    {
+        parent->lastChild = newView;
+    }
 
     if (prev != NULL)
     {
@@ -538,10 +1100,21 @@ void nkView_ReplaceView(nkView_t *oldView, nkView_t *newView)
         parent->child = newView;
     }
 
+    DamageSubtree(parent, oldView);
+    CountListingViews(parent, oldView, false);
+    UnqueueMeasure(oldView);
+
     /* Isolate the old view completely */
     oldView->parent = NULL;
     oldView->sibling = NULL;
     oldView->prevSibling = NULL;
+
+    NotifyChildList(parent, newView, true);
+    DamageSubtree(parent, newView);
+    CountListingViews(parent, newView, true);
+
+    PropagateDirtyFlags(newView);
+    nkView_InvalidateMeasure(parent);
 }
 
 nkView_t *nkView_NextViewInTree(nkView_t *view)
@@ -599,13 +1172,9 @@ nkView_t *nkView_DeepestViewInTree(nkView_t *view)
         return NULL;
     }
 
-    while (view->child != NULL)
+    while (view->lastChild != NULL)
     {
-        view = view->child;
-        while (view->sibling != NULL)
-        {
-            view = view->sibling;
-        }
+        view = view->lastChild;
     }
 
     return view;
@@ -638,14 +1207,7 @@ nkView_t *nkView_LastChildView(nkView_t *view)
         return NULL;
     }
 
-    nkView_t *lastChild = view->child;
-
-    while (lastChild != NULL && lastChild->sibling != NULL)
-    {
-        lastChild = lastChild->sibling;
-    }
-
-    return lastChild;
+    return view->lastChild;
 }
 
 nkView_t *nkView_NextSiblingView(nkView_t *view)
@@ -691,8 +1253,242 @@ size_t nkView_GetDepthInTree(nkView_t *view)
     return depth;
 }
 
+bool nkView_FreezeSubtree(nkView_t *view)
+{
+    if (view == NULL)
+    {
+        return false;
+    }
+
+    if (view->frozen != NULL)
+    {
+        return true;
+    }
+
+    if (FrozenAncestor(view->parent) != NULL)
+    {
+        return false;
+    }
+
+    nkViewIterator_t iterator;
+    size_t count = 0;
+    size_t maxDepth = 0;
+
+    for (nkView_t *node = nkView_PreOrderBegin(&iterator, view); node; node = nkView_PreOrderNext(&iterator))
+    {
+        /* views that pick their own children to visit can't be flattened */
+        if (node->queryChildrenCallback)
+        {
+            return false;
+        }
+
+        /* only the outermost subtree stays frozen */
+        nkView_ThawSubtree(node);
+
+        count++;
+        maxDepth = (iterator.depth > maxDepth) ? iterator.depth : maxDepth;
+    }
+
+    if (count >= UINT32_MAX)
+    {
+        return false;
+    }
+
+    nkFrozenSubtree_t *frozen = calloc(1, sizeof(nkFrozenSubtree_t));
+    uint32_t *lastAtDepth = malloc((maxDepth + 1) * sizeof(uint32_t));
+
+    if (frozen == NULL || lastAtDepth == NULL)
+    {
+        free(frozen);
+        free(lastAtDepth);
+        return false;
+    }
+
+    frozen->count = count;
+    frozen->views = malloc(count * sizeof(nkView_t *));
+    frozen->frames = malloc(count * sizeof(nkRect_t));
+    frozen->parents = malloc(count * sizeof(uint32_t));
+    frozen->ends = malloc(count * sizeof(uint32_t));
+    frozen->depths = malloc(count * sizeof(uint32_t));
+    frozen->offsets = malloc(count * sizeof(nkPoint_t));
+
+    view->frozen = frozen;
+
+    if (!frozen->views || !frozen->frames
+        || !frozen->parents || !frozen->ends || !frozen->depths || !frozen->offsets)
+    {
+        nkView_ThawSubtree(view);
+        free(lastAtDepth);
+        return false;
+    }
+
+    uint32_t index = 0;
+
+    for (nkView_t *node = nkView_PreOrderBegin(&iterator, view); node; node = nkView_PreOrderNext(&iterator), index++)
+    {
+        lastAtDepth[iterator.depth] = index;
+
+        frozen->views[index] = node;
+        frozen->depths[index] = (uint32_t)iterator.depth;
+        frozen->parents[index] = (iterator.depth > 0) ? lastAtDepth[iterator.depth - 1] : 0;
+        frozen->ends[index] = index + 1;
+    }
+
+    /* descendants come later in pre-order, so one backwards pass extends each end */
+    for (size_t i = count; i-- > 1;)
+    {
+        uint32_t parent = frozen->parents[i];
+
+        if (frozen->ends[i] > frozen->ends[parent])
+        {
+            frozen->ends[parent] = frozen->ends[i];
+        }
+    }
+
+    free(lastAtDepth);
+
+    SyncFrozen(frozen);
+
+    return true;
+}
+
+void nkView_ThawSubtree(nkView_t *view)
+{
+    if (view == NULL || view->frozen == NULL)
+    {
+        return;
+    }
+
+    nkFrozenSubtree_t *frozen = view->frozen;
+
+    free(frozen->views);
+    free(frozen->frames);
+    free(frozen->parents);
+    free(frozen->ends);
+    free(frozen->depths);
+    free(frozen->offsets);
+    free(frozen);
+
+    view->frozen = NULL;
+}
+
+nkView_t *nkView_PreOrderBegin(nkViewIterator_t *iterator, nkView_t *root)
+{
+    if (iterator == NULL)
+    {
+        return NULL;
+    }
+
+    iterator->root = root;
+    iterator->view = root;
+    iterator->depth = 0;
+
+    return root;
+}
+
+nkView_t *nkView_PreOrderNext(nkViewIterator_t *iterator)
+{
+    if (iterator == NULL || iterator->view == NULL)
+    {
+        return NULL;
+    }
+
+    if (iterator->view->child != NULL)
+    {
+        iterator->view = iterator->view->child;
+        iterator->depth++;
+
+        return iterator->view;
+    }
+
+    return nkView_PreOrderSkipChildren(iterator);
+}
+
+nkView_t *nkView_PreOrderSkipChildren(nkViewIterator_t *iterator)
+{
+    if (iterator == NULL || iterator->view == NULL)
+    {
+        return NULL;
+    }
+
+    nkView_t *view = iterator->view;
+
+    while (view != iterator->root && view->sibling == NULL)
+    {
+        view = view->parent;
+        iterator->depth--;
+    }
+
+    iterator->view = (view != iterator->root) ? view->sibling : NULL;
+
+    return iterator->view;
+}
+
+nkView_t *nkView_PostOrderBegin(nkViewIterator_t *iterator, nkView_t *root)
+{
+    if (iterator == NULL)
+    {
+        return NULL;
+    }
+
+    iterator->root = root;
+    iterator->view = root;
+    iterator->depth = 0;
+
+    while (iterator->view != NULL && iterator->view->child != NULL)
+    {
+        iterator->view = iterator->view->child;
+        iterator->depth++;
+    }
+
+    return iterator->view;
+}
+
+nkView_t *nkView_PostOrderNext(nkViewIterator_t *iterator)
+{
+    if (iterator == NULL || iterator->view == NULL)
+    {
+        return NULL;
+    }
+
+    nkView_t *view = iterator->view;
+
+    if (view == iterator->root)
+    {
+        iterator->view = NULL;
+        return NULL;
+    }
+
+    if (view->sibling == NULL)
+    {
+        iterator->view = view->parent;
+        iterator->depth--;
+
+        return iterator->view;
+    }
+
+    /* descend to the first leaf of the next sibling's subtree */
+    view = view->sibling;
+
+    while (view->child != NULL)
+    {
+        view = view->child;
+        iterator->depth++;
+    }
+
+    iterator->view = view;
+
+    return view;
+}
+
 nkView_t* nkView_HitTest(nkView_t *view, float x, float y)
 {
+    if (!view)
+    {
+        return NULL;
+    }
+
+    stats.hitTestViews++;
 
     bool inView = (
             (x >= view->frame.x)
@@ -702,25 +1498,72 @@ nkView_t* nkView_HitTest(nkView_t *view, float x, float y)
     );
 
     /* if not in this view, neither view nor any child can pass the test */
-    if (!view || !inView)
+    if (!inView)
     {
         return NULL;
     }
 
-    /* search children top-down */
-    nkView_t *child = nkView_LastChildView(view);
+    if (view->frozen != NULL)
+    {
+        return HitTestFrozen(view->frozen, x, y);
+    }
+
+    /* children's frames are in their own coords */
+    float childX = x - view->childOffset.x;
+    float childY = y - view->childOffset.y;
+
+    if (view->queryChildrenCallback)
+    {
+        /* the view narrows down its own children */
+        nkView_t *const *children = NULL;
+        size_t count = view->queryChildrenCallback(view, (nkRect_t){childX, childY, 0, 0}, &children);
+
+        for (size_t i = count; i-- > 0;)
+        {
+            nkView_t *hitView = nkView_HitTest(children[i], childX, childY);
 
-    while (child)
+            if (hitView)
+            {
+                return hitView;
+            }
+        }
+    }
+    else if (view->childCount >= NK_HIT_INDEX_MIN_CHILDREN && PrepareHitIndex(view) != NULL)
     {
-        nkView_t *hitView = nkView_HitTest(child, x, y);
+        /* only the children under the point, still top-down */
+        uint32_t below = UINT32_MAX;
+        uint32_t order;
+        nkView_t *child;
 
-        if (hitView)
+        while ((child = nkHitIndex_Topmost(view->hitIndex, childX, childY, below, &order)) != NULL)
         {
-            /* a child passed the hit test, so this takes precedence */
-            return hitView;
+            nkView_t *hitView = nkView_HitTest(child, childX, childY);
+
+            if (hitView)
+            {
+                return hitView;
+            }
+
+            below = order;
         }
+    }
+    else
+    {
+        /* search children top-down */
+        nkView_t *child = nkView_LastChildView(view);
+
+        while (child)
+        {
+            nkView_t *hitView = nkView_HitTest(child, childX, childY);
 
-        child = nkView_PreviousSiblingView(child);
+            if (hitView)
+            {
+                /* a child passed the hit test, so this takes precedence */
+                return hitView;
+            }
+
+            child = nkView_PreviousSiblingView(child);
+        }
     }
 
     /* check if this view wants events */
@@ -733,44 +1576,173 @@ nkView_t* nkView_HitTest(nkView_t *view, float x, float y)
     return NULL;
 }
 
-/* places the view at the given frame, applying alignment and margin */
-void nkView_PlaceView(nkView_t *view, nkRect_t frame)
+nkRect_t nkView_VisibleRegion(nkView_t *view)
 {
     if (view == NULL)
     {
-        return;
+        return (nkRect_t){0, 0, 0, 0};
     }
 
-    /* fit child to frame */
-    switch (view->verticalAlignment)
+    /* each frame is moved into the window by the offsets above it */
+    nkPoint_t offset = nkView_WindowOffset(view);
+    nkView_t *ancestor = view;
+
+    float left = -INFINITY;
+    float top = -INFINITY;
+    float right = INFINITY;
+    float bottom = INFINITY;
+
+    while (ancestor != NULL)
     {
-        case ALIGNMENT_TOP:
+        if (ancestor->clipToBounds || ancestor->parent == NULL)
         {
-            view->frame.height = fminf(view->sizeRequest.height, frame.height);
-            view->frame.y = frame.y + view->margin.top;
-        } break;
+            nkRect_t clip = Translate(ancestor->frame, offset);
 
-        case ALIGNMENT_MIDDLE:
-        {
-            view->frame.height = fminf(view->sizeRequest.height, frame.height);
-            view->frame.y = frame.y + (frame.height - view->frame.height) / 2.0f;
+            left = fmaxf(left, clip.x);
+            top = fmaxf(top, clip.y);
+            right = fminf(right, clip.x + clip.width);
+            bottom = fminf(bottom, clip.y + clip.height);
+        }
 
-            if (view->frame.y < frame.y + view->margin.top)
-            {
-                view->frame.y = frame.y + view->margin.top; /* Ensure it doesn't go above the margin */
-            }
-        } break;
+        ancestor = ancestor->parent;
 
-        case ALIGNMENT_BOTTOM:
+        if (ancestor != NULL)
         {
-            view->frame.height = fminf(view->sizeRequest.height, frame.height);
-            view->frame.y = frame.y + (frame.height - view->frame.height);
+            offset.x -= ancestor->childOffset.x;
+            offset.y -= ancestor->childOffset.y;
+        }
+    }
 
-            if (view->frame.y + view->frame.height > frame.y + frame.height - view->margin.bottom)
-            {
-                view->frame.y = frame.y + frame.height - view->frame.height - view->margin.bottom; /* Ensure it doesn't go below the margin */
-            }
-        } break;
+    return (nkRect_t){left, top, fmaxf(0.0f, right - left), fmaxf(0.0f, bottom - top)};
+}
+
+nkRect_t nkView_VisibleChildRegion(nkView_t *view)
+{
+    if (view == NULL)
+    {
+        return (nkRect_t){0, 0, 0, 0};
+    }
+
+    nkPoint_t offset = nkView_WindowOffset(view);
+    offset.x = -(offset.x + view->childOffset.x);
+    offset.y = -(offset.y + view->childOffset.y);
+
+    return Translate(nkView_VisibleRegion(view), offset);
+}
+
+nkSize_t nkView_Measure(nkView_t *view, nkSize_t available, nkDrawContext_t *context)
+{
+    if (view == NULL)
+    {
+        return (nkSize_t){0, 0};
+    }
+
+    nkMeasureCache_t *cache = &view->measureCache;
+
+    if (MeasureCurrent(view) && SizeEquals(cache->constraint, available))
+    {
+        view->needsMeasure = false;
+        return cache->result;
+    }
+
+    if (view->measureSizeCallback)
+    {
+        stats.layoutCallbacks++;
+
+        BeginMeasureCallback(view);
+        PROFILE_BEGIN();
+        view->sizeRequest = view->measureSizeCallback(view, available, context);
+        PROFILE_END(view, NK_PROFILE_MEASURE);
+        EndMeasureCallback(view);
+    }
+    else
+    {
+        /* compatibility: legacy callbacks read their children's sizeRequest,
+           so measure the children that have none yet. Ones measured already,
+           by the bottom-up pass or a container, keep their own constraint. */
+        nkView_t *child = view->child;
+
+        while (child)
+        {
+            nkMeasureCache_t *childCache = &child->measureCache;
+
+            if (!childCache->valid)
+            {
+                nkView_Measure(child, available, context);
+            }
+            else if (!MeasureCurrent(child))
+            {
+                nkView_Measure(child, childCache->constraint, context);
+            }
+
+            child = child->sibling;
+        }
+
+        if (view->measureCallback)
+        {
+            stats.layoutCallbacks++;
+
+            BeginMeasureCallback(view);
+            PROFILE_BEGIN();
+            view->measureCallback(view, context);
+            PROFILE_END(view, NK_PROFILE_MEASURE);
+            EndMeasureCallback(view);
+        }
+    }
+
+    *cache = (nkMeasureCache_t){
+        available,
+        view->sizeRequest,
+        view->contentVersion,
+        textMetrics,
+        (textMetrics != NULL) ? textMetrics->generation : 0,
+        true
+    };
+    view->needsMeasure = false;
+
+    return view->sizeRequest;
+}
+
+/* places the view at the given frame, applying alignment and margin */
+void nkView_PlaceView(nkView_t *view, nkRect_t frame)
+{
+    if (view == NULL)
+    {
+        return;
+    }
+
+    nkRect_t previousFrame = view->frame;
+
+    /* fit child to frame */
+    switch (view->verticalAlignment)
+    {
+        case ALIGNMENT_TOP:
+        {
+            view->frame.height = FitSize(view->sizeRequest.height, frame.height);
+            view->frame.y = frame.y + view->margin.top;
+        } break;
+
+        case ALIGNMENT_MIDDLE:
+        {
+            view->frame.height = FitSize(view->sizeRequest.height, frame.height);
+            view->frame.y = frame.y + (frame.height - view->frame.height) / 2.0f;
+
+            if (view->frame.y < frame.y + view->margin.top)
+            {
+                view->frame.y = frame.y + view->margin.top; /* Ensure it doesn't go above the margin */
+            }
+        } break;
+
+        case ALIGNMENT_BOTTOM:
+        {
+            view->frame.height = FitSize(view->sizeRequest.height, frame.height);
+            view->frame.y = frame.y + (frame.height - view->frame.height);
+
+            if (view->frame.y + view->frame.height > frame.y + frame.height - view->margin.bottom)
+            {
+                view->frame.y = frame.y + frame.height - view->frame.height - view->margin.bottom; /* Ensure it doesn't go below the margin */
+            }
+        } break;
 
         default:
         {
@@ -783,13 +1755,13 @@ void nkView_PlaceView(nkView_t *view, nkRect_t frame)
     {
         case ALIGNMENT_LEFT:
         {
-            view->frame.width = fminf(view->sizeRequest.width, frame.width);
+            view->frame.width = FitSize(view->sizeRequest.width, frame.width);
             view->frame.x = frame.x + view->margin.left;
         } break;
 
         case ALIGNMENT_CENTER:
         {
-            view->frame.width = fminf(view->sizeRequest.width, frame.width);
+            view->frame.width = FitSize(view->sizeRequest.width, frame.width);
             view->frame.x = frame.x + (frame.width - view->frame.width) / 2.0f;
 
             if (view->frame.x < frame.x + view->margin.left)
@@ -800,7 +1772,7 @@ void nkView_PlaceView(nkView_t *view, nkRect_t frame)
 
         case ALIGNMENT_RIGHT:
         {
-            view->frame.width = fminf(view->sizeRequest.width, frame.width);
+            view->frame.width = FitSize(view->sizeRequest.width, frame.width);
             view->frame.x = frame.x + (frame.width - view->frame.width);
 
             if (view->frame.x + view->frame.width > frame.x + frame.width - view->margin.right)
@@ -815,10 +1787,1859 @@ void nkView_PlaceView(nkView_t *view, nkRect_t frame)
             view->frame.x = frame.x + view->margin.left;
         } break;
     }
-    
+
+    MarkFrameChange(view, previousFrame);
+}
+
+void nkView_PlaceViews(nkView_t **views, const nkRect_t *frames, size_t count)
+{
+    if (views == NULL || frames == NULL)
+    {
+        return;
+    }
+
+    size_t i = 0;
+
+#ifdef NANOVIEW_SSE
+    for (; i + 4 <= count; i += 4)
+    {
+        if (views[i] && views[i + 1] && views[i + 2] && views[i + 3])
+        {
+            PlaceViews4(&views[i], &frames[i]);
+        }
+        else
+        {
+            for (size_t j = i; j < i + 4; j++)
+            {
+                nkView_PlaceView(views[j], frames[j]);
+            }
+        }
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        nkView_PlaceView(views[i], frames[i]);
+    }
 }
 
 
 /***************************************************************
 ** MARK: STATIC FUNCTIONS
-***************************************************************/
\ No newline at end of file
+***************************************************************/
+
+static bool RectEquals(nkRect_t a, nkRect_t b)
+{
+    return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+}
+
+static bool RectIsEmpty(nkRect_t rect)
+{
+    return !(rect.width > 0.0f && rect.height > 0.0f);
+}
+
+static bool RectsOverlap(nkRect_t a, nkRect_t b)
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+        a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+static bool RectContains(nkRect_t outer, nkRect_t inner)
+{
+    return outer.x <= inner.x && outer.y <= inner.y &&
+        inner.x + inner.width <= outer.x + outer.width &&
+        inner.y + inner.height <= outer.y + outer.height;
+}
+
+static nkRect_t RectIntersection(nkRect_t a, nkRect_t b)
+{
+    float left = fmaxf(a.x, b.x);
+    float top = fmaxf(a.y, b.y);
+    float right = fminf(a.x + a.width, b.x + b.width);
+    float bottom = fminf(a.y + a.height, b.y + b.height);
+
+    return (nkRect_t){left, top, fmaxf(0.0f, right - left), fmaxf(0.0f, bottom - top)};
+}
+
+/* empty rects add nothing */
+static nkRect_t RectUnion(nkRect_t a, nkRect_t b)
+{
+    if (RectIsEmpty(a))
+    {
+        return b;
+    }
+
+    if (RectIsEmpty(b))
+    {
+        return a;
+    }
+
+    float left = fminf(a.x, b.x);
+    float top = fminf(a.y, b.y);
+    float right = fmaxf(a.x + a.width, b.x + b.width);
+    float bottom = fmaxf(a.y + a.height, b.y + b.height);
+
+    return (nkRect_t){left, top, right - left, bottom - top};
+}
+
+static nkRect_t Translate(nkRect_t rect, nkPoint_t offset)
+{
+    return (nkRect_t){rect.x + offset.x, rect.y + offset.y, rect.width, rect.height};
+}
+
+/* a moved or resized view must re-arrange its own children */
+static void MarkFrameChange(nkView_t *view, nkRect_t previousFrame)
+{
+    if (!RectEquals(previousFrame, view->frame))
+    {
+        DamageFrame(view, previousFrame);
+        HitFrameChanged(view);
+
+        view->needsArrange = true;
+
+        if (arranging)
+        {
+            if (view->parent != NULL)
+            {
+                view->parent->childNeedsArrange = true;
+            }
+        }
+        else
+        {
+            /* placed outside a layout pass, so the next one must find it from the root */
+            PropagateDirtyFlags(view);
+        }
+    }
+}
+
+/* the smaller of the two, ignoring a NaN in either like fminf, but with
+   ties and NaNs settled by operand order rather than by libm, so PlaceAxis4
+   can give the same bits: request on a tie (a zero keeps its sign), and
+   available if request is NaN. */
+static float FitSize(float request, float available)
+{
+    if (isnan(request))
+    {
+        return available;
+    }
+
+    return (available < request) ? available : request;
+}
+
+#ifdef NANOVIEW_SSE
+
+/* nkView_PlaceView for four views at once. Every alignment case is computed
+   for all lanes and the right one selected per lane, with the same operation
+   order as the scalar code, so results are bit-identical in every build. */
+static void PlaceViews4(nkView_t **views, const nkRect_t *frames)
+{
+    float frameX[4], frameY[4], frameWidth[4], frameHeight[4];
+    float requestWidth[4], requestHeight[4];
+    float left[4], top[4], right[4], bottom[4];
+    int32_t horizontal[4], vertical[4];
+
+    for (int i = 0; i < 4; i++)
+    {
+        nkView_t *view = views[i];
+
+        frameX[i] = frames[i].x;
+        frameY[i] = frames[i].y;
+        frameWidth[i] = frames[i].width;
+        frameHeight[i] = frames[i].height;
+        requestWidth[i] = view->sizeRequest.width;
+        requestHeight[i] = view->sizeRequest.height;
+        left[i] = view->margin.left;
+        top[i] = view->margin.top;
+        right[i] = view->margin.right;
+        bottom[i] = view->margin.bottom;
+        horizontal[i] = (int32_t)view->horizontalAlignment;
+        vertical[i] = (int32_t)view->verticalAlignment;
+    }
+
+    __m128 x, y, width, height;
+
+    PlaceAxis4(_mm_loadu_ps(frameY), _mm_loadu_ps(frameHeight), _mm_loadu_ps(requestHeight),
+        _mm_loadu_ps(top), _mm_loadu_ps(bottom), _mm_loadu_si128((const __m128i *)vertical), &y, &height);
+
+    PlaceAxis4(_mm_loadu_ps(frameX), _mm_loadu_ps(frameWidth), _mm_loadu_ps(requestWidth),
+        _mm_loadu_ps(left), _mm_loadu_ps(right), _mm_loadu_si128((const __m128i *)horizontal), &x, &width);
+
+    float outX[4], outY[4], outWidth[4], outHeight[4];
+
+    _mm_storeu_ps(outX, x);
+    _mm_storeu_ps(outY, y);
+    _mm_storeu_ps(outWidth, width);
+    _mm_storeu_ps(outHeight, height);
+
+    for (int i = 0; i < 4; i++)
+    {
+        nkView_t *view = views[i];
+        nkRect_t previousFrame = view->frame;
+
+        view->frame = (nkRect_t){outX[i], outY[i], outWidth[i], outHeight[i]};
+
+        MarkFrameChange(view, previousFrame);
+    }
+}
+
+/* one axis of PlaceViews4. Alignment values 1, 2 and 3 are start, centre and
+   end on both axes (left/top, center/middle, right/bottom); anything else
+   stretches, like the scalar default case. */
+static void PlaceAxis4(__m128 framePos, __m128 frameSize, __m128 request, __m128 leading, __m128 trailing, __m128i alignment, __m128 *pos, __m128 *size)
+{
+    __m128 isStart = _mm_castsi128_ps(_mm_cmpeq_epi32(alignment, _mm_set1_epi32(1)));
+    __m128 isCenter = _mm_castsi128_ps(_mm_cmpeq_epi32(alignment, _mm_set1_epi32(2)));
+    __m128 isEnd = _mm_castsi128_ps(_mm_cmpeq_epi32(alignment, _mm_set1_epi32(3)));
+    __m128 isAligned = _mm_or_ps(isStart, _mm_or_ps(isCenter, isEnd));
+
+    /* FitSize(request, frameSize): minps gives its second operand on a tie or NaN */
+    __m128 clamped = _mm_min_ps(frameSize, request);
+    __m128 requestNaN = _mm_cmpunord_ps(request, request);
+    clamped = _mm_or_ps(_mm_and_ps(requestNaN, frameSize), _mm_andnot_ps(requestNaN, clamped));
+
+    __m128 leadingPos = _mm_add_ps(framePos, leading);
+
+    /* centre: halfway, but not above the leading margin */
+    __m128 centerPos = _mm_add_ps(framePos, _mm_div_ps(_mm_sub_ps(frameSize, clamped), _mm_set1_ps(2.0f)));
+    __m128 centerLow = _mm_cmplt_ps(centerPos, leadingPos);
+    centerPos = _mm_or_ps(_mm_and_ps(centerLow, leadingPos), _mm_andnot_ps(centerLow, centerPos));
+
+    /* end: flush with the far edge, but not past the trailing margin */
+    __m128 frameEnd = _mm_add_ps(framePos, frameSize);
+    __m128 endPos = _mm_add_ps(framePos, _mm_sub_ps(frameSize, clamped));
+    __m128 endHigh = _mm_cmpgt_ps(_mm_add_ps(endPos, clamped), _mm_sub_ps(frameEnd, trailing));
+    __m128 endLimit = _mm_sub_ps(_mm_sub_ps(frameEnd, clamped), trailing);
+    endPos = _mm_or_ps(_mm_and_ps(endHigh, endLimit), _mm_andnot_ps(endHigh, endPos));
+
+    __m128 stretchSize = _mm_sub_ps(_mm_sub_ps(frameSize, leading), trailing);
+
+    __m128 alignedPos = _mm_or_ps(_mm_and_ps(isStart, leadingPos),
+        _mm_or_ps(_mm_and_ps(isCenter, centerPos), _mm_and_ps(isEnd, endPos)));
+
+    *pos = _mm_or_ps(alignedPos, _mm_andnot_ps(isAligned, leadingPos));
+    *size = _mm_or_ps(_mm_and_ps(isAligned, clamped), _mm_andnot_ps(isAligned, stretchSize));
+}
+
+#endif /* NANOVIEW_SSE */
+
+static bool SizeEquals(nkSize_t a, nkSize_t b)
+{
+    return a.width == b.width && a.height == b.height;
+}
+
+/* the cached result still holds for the content and the text metrics in use */
+static bool MeasureCurrent(const nkView_t *view)
+{
+    const nkMeasureCache_t *cache = &view->measureCache;
+
+    return cache->valid
+        && cache->version == view->contentVersion
+        && cache->metrics == textMetrics
+        && cache->metricsGeneration == ((textMetrics != NULL) ? textMetrics->generation : 0);
+}
+
+/* marks the ancestors of a dirty view so the layout passes can find it,
+   stopping at the first ancestor which is already marked */
+static void PropagateDirtyFlags(nkView_t *view)
+{
+    bool measure = view->needsMeasure || view->childNeedsMeasure;
+    bool arrange = view->needsArrange || view->childNeedsArrange;
+
+    nkView_t *parent = view->parent;
+
+    while (parent != NULL && (measure || arrange))
+    {
+        if (measure)
+        {
+            /* listed even when the parent is already marked, as it may
+               be for another child */
+            QueueMeasure(view);
+
+            measure = !parent->childNeedsMeasure;
+            parent->childNeedsMeasure = true;
+        }
+
+        if (arrange)
+        {
+            arrange = !parent->childNeedsArrange;
+            parent->childNeedsArrange = true;
+        }
+
+        view = parent;
+        parent = parent->parent;
+    }
+}
+
+/* adds or takes the subtree's listing views from parent and its ancestors */
+static void CountListingViews(nkView_t *parent, const nkView_t *subtree, bool added)
+{
+    size_t count = subtree->listingDescendants + (subtree->queryChildrenCallback != NULL);
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    for (nkView_t *ancestor = parent; ancestor != NULL; ancestor = ancestor->parent)
+    {
+        if (added)
+        {
+            ancestor->listingDescendants += count;
+        }
+        else
+        {
+            ancestor->listingDescendants -= (count < ancestor->listingDescendants) ? count : ancestor->listingDescendants;
+        }
+    }
+}
+
+static void NotifyChildList(nkView_t *parent, nkView_t *child, bool added)
+{
+    if (parent->childListCallback)
+    {
+        parent->childListCallback(parent, child, added);
+    }
+}
+
+/* The views below (and including) view which list their own children may now
+   show ones that were never placed or arranged. They are marked from the
+   root, so the next layout pass asks them again before anything is drawn. */
+static void RevealListedChildren(nkView_t *view)
+{
+    nkViewIterator_t iterator;
+    nkView_t *node = nkView_PreOrderBegin(&iterator, view);
+
+    while (node)
+    {
+        if (node->queryChildrenCallback)
+        {
+            node->childNeedsArrange = true;
+            PropagateDirtyFlags(node);
+        }
+
+        node = (node->listingDescendants > 0) ? nkView_PreOrderNext(&iterator) : nkView_PreOrderSkipChildren(&iterator);
+    }
+}
+
+static void QueueMeasure(nkView_t *view)
+{
+    nkView_t *parent = view->parent;
+
+    if (view->queued || parent == NULL)
+    {
+        return;
+    }
+
+    view->prevQueued = NULL;
+    view->nextQueued = parent->measureQueue;
+
+    if (parent->measureQueue != NULL)
+    {
+        parent->measureQueue->prevQueued = view;
+    }
+
+    parent->measureQueue = view;
+    view->queued = true;
+}
+
+static void UnqueueMeasure(nkView_t *view)
+{
+    if (!view->queued)
+    {
+        return;
+    }
+
+    if (view->prevQueued != NULL)
+    {
+        view->prevQueued->nextQueued = view->nextQueued;
+    }
+    else
+    {
+        view->parent->measureQueue = view->nextQueued;
+    }
+
+    if (view->nextQueued != NULL)
+    {
+        view->nextQueued->prevQueued = view->prevQueued;
+    }
+
+    view->nextQueued = NULL;
+    view->prevQueued = NULL;
+    view->queued = false;
+}
+
+static void PropagateRedrawFlags(nkView_t *view)
+{
+    for (nkView_t *parent = view->parent; parent != NULL && !parent->childNeedsRedraw; parent = parent->parent)
+    {
+        parent->childNeedsRedraw = true;
+    }
+}
+
+/* both where the view was and where it is now need repainting */
+static void DamageFrame(nkView_t *view, nkRect_t previousFrame)
+{
+    view->staleBounds = RectUnion(view->staleBounds, previousFrame);
+    view->needsRedraw = true;
+    view->visualVersion++;
+
+    PropagateRedrawFlags(view);
+    InvalidateSubtreeBounds(view);
+}
+
+/* children may draw outside their parent, so a subtree joining or leaving
+   view damages everything it was last placed over. The damage is view's, so
+   only view's ancestors clip it. subtree is view or one of its children. */
+static void DamageSubtree(nkView_t *view, nkView_t *subtree)
+{
+    nkRect_t bounds = StaleSubtreeBounds(subtree);
+
+    if (subtree != view)
+    {
+        bounds = Translate(bounds, view->childOffset);
+    }
+
+    view->staleBounds = RectUnion(view->staleBounds, bounds);
+
+    PropagateRedrawFlags(view);
+    InvalidateSubtreeBounds(view);
+}
+
+/* frames and stale bounds of the subtree, in the view's frame coords */
+static nkRect_t StaleSubtreeBounds(nkView_t *view)
+{
+    nkRect_t bounds = RectUnion(view->frame, view->staleBounds);
+
+    for (nkView_t *child = view->child; child != NULL; child = child->sibling)
+    {
+        bounds = RectUnion(bounds, Translate(StaleSubtreeBounds(child), view->childOffset));
+    }
+
+    return bounds;
+}
+
+/* stops at views already invalid, as their ancestors were cleared with them,
+   and below views whose bounds don't depend on their children's */
+static void InvalidateSubtreeBounds(nkView_t *view)
+{
+    while (view != NULL && view->subtreeBoundsValid)
+    {
+        view->subtreeBoundsValid = false;
+
+        if (view->parent != NULL)
+        {
+            view->parent->childrenSpillValid = false;
+        }
+
+        if (view->parent != NULL && (view->parent->clipToBounds || view->parent->queryChildrenCallback))
+        {
+            break;
+        }
+
+        view = view->parent;
+    }
+}
+
+/* the area the subtree can draw over, recomputed only below invalidated
+   views. Views listing their own children cull them as they are listed, so
+   are never culled whole unless they clip. */
+static nkRect_t SubtreeBounds(nkView_t *view)
+{
+    if (view->subtreeBoundsValid)
+    {
+        return view->subtreeBounds;
+    }
+
+    nkRect_t bounds = view->frame;
+
+    if (!view->clipToBounds && view->queryChildrenCallback)
+    {
+        bounds = UNBOUNDED_RECT;
+    }
+    else if (!view->clipToBounds)
+    {
+        for (nkView_t *child = view->child; child != NULL; child = child->sibling)
+        {
+            bounds = RectUnion(bounds, Translate(SubtreeBounds(child), view->childOffset));
+        }
+    }
+
+    view->subtreeBounds = bounds;
+    view->subtreeBoundsValid = true;
+
+    return bounds;
+}
+
+/* Whether the children's frames in the hit index can stand in for their
+   subtree bounds, leaving the frames' union in childrenBounds when they can.
+   Found once per change to a child's bounds, stopping at the first child
+   that reaches out; every child is then valid, so the next change to any of
+   them clears the answer again. */
+static bool ChildrenSpill(nkView_t *view)
+{
+    if (view->childrenSpillValid && view->childrenSpillVersion == view->structureVersion)
+    {
+        return view->childrenSpill;
+    }
+
+    bool spill = false;
+    nkRect_t bounds = (view->child != NULL) ? view->child->frame : (nkRect_t){0.0f, 0.0f, 0.0f, 0.0f};
+
+    for (nkView_t *child = view->child; child != NULL && !spill; child = child->sibling)
+    {
+        spill = !RectContains(child->frame, SubtreeBounds(child));
+        bounds = RectUnion(bounds, child->frame);
+    }
+
+    view->childrenSpill = spill;
+    view->childrenBounds = bounds;
+    view->childrenSpillValid = true;
+    view->childrenSpillVersion = view->structureVersion;
+
+    return spill;
+}
+
+/* gathers the damage of every flagged view, cut down by the clipping views
+   above it, and clears the flags. Clean subtrees are skipped whole. */
+static void CollectDamage(nkView_t *root, nkDamageRegion_t *damage)
+{
+    if (!CollectSubtreeDamage(root, 0, damage))
+    {
+        /* the flags left set are collected again next time */
+        nkDamageRegion_Add(damage, root->frame);
+    }
+}
+
+/* root sits at depth in the walk, whose clip and offset are already set
+   unless it is the tree's root. Views listing their own children only have
+   the visible ones visited, as damage elsewhere can't be seen. False if the
+   working storage ran out. */
+static bool CollectSubtreeDamage(nkView_t *root, size_t depth, nkDamageRegion_t *damage)
+{
+    nkViewIterator_t iterator;
+    nkView_t *view = nkView_PreOrderBegin(&iterator, root);
+
+    while (view)
+    {
+        size_t viewDepth = depth + iterator.depth;
+
+        if (!view->needsRedraw && !view->childNeedsRedraw && RectIsEmpty(view->staleBounds))
+        {
+            view = nkView_PreOrderSkipChildren(&iterator);
+            continue;
+        }
+
+        /* clips[viewDepth] is what the ancestors of the view let show, and
+           offsets[viewDepth] moves its frame coords into the window */
+        if (viewDepth + 2 > damage->clipCapacity)
+        {
+            size_t capacity = (damage->clipCapacity > 0) ? damage->clipCapacity * 2 : 64;
+            nkRect_t *clips = realloc(damage->clips, capacity * sizeof(nkRect_t));
+            nkPoint_t *offsets = (clips != NULL) ? realloc(damage->offsets, capacity * sizeof(nkPoint_t)) : NULL;
+
+            if (clips != NULL)
+            {
+                damage->clips = clips;
+            }
+
+            if (offsets == NULL)
+            {
+                return false;
+            }
+
+            damage->offsets = offsets;
+            damage->clipCapacity = capacity;
+        }
+
+        if (viewDepth == 0)
+        {
+            damage->clips[0] = root->frame;
+            damage->offsets[0] = (nkPoint_t){0, 0};
+        }
+
+        nkRect_t clip = damage->clips[viewDepth];
+        nkPoint_t offset = damage->offsets[viewDepth];
+
+        if (view->needsRedraw)
+        {
+            nkDamageRegion_Add(damage, RectIntersection(Translate(view->frame, offset), clip));
+            view->needsRedraw = false;
+        }
+
+        if (!RectIsEmpty(view->staleBounds))
+        {
+            nkDamageRegion_Add(damage, RectIntersection(Translate(view->staleBounds, offset), clip));
+            view->staleBounds = (nkRect_t){0, 0, 0, 0};
+        }
+
+        if (!view->childNeedsRedraw)
+        {
+            view = nkView_PreOrderSkipChildren(&iterator);
+            continue;
+        }
+
+        nkRect_t childClip = view->clipToBounds ? RectIntersection(clip, Translate(view->frame, offset)) : clip;
+        nkPoint_t childOffset = {offset.x + view->childOffset.x, offset.y + view->childOffset.y};
+
+        view->childNeedsRedraw = false;
+        damage->clips[viewDepth + 1] = childClip;
+        damage->offsets[viewDepth + 1] = childOffset;
+
+        if (view->queryChildrenCallback)
+        {
+            nkView_t *const *children = NULL;
+            size_t count = view->queryChildrenCallback(view, Translate(childClip, (nkPoint_t){-childOffset.x, -childOffset.y}), &children);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                if (!CollectSubtreeDamage(children[i], viewDepth + 1, damage))
+                {
+                    return false;
+                }
+            }
+
+            view = nkView_PreOrderSkipChildren(&iterator);
+            continue;
+        }
+
+        view = nkView_PreOrderNext(&iterator);
+    }
+
+    return true;
+}
+
+/* takes listed children off the parent's queue until one has measure work.
+   Children measured since they were listed, by a container or another pass,
+   are dropped on the way. */
+static nkView_t *NextQueuedMeasure(nkView_t *parent)
+{
+    nkView_t *child = parent->measureQueue;
+
+    while (child != NULL)
+    {
+        UnqueueMeasure(child);
+
+        if (child->needsMeasure || child->childNeedsMeasure)
+        {
+            return child;
+        }
+
+        child = parent->measureQueue;
+    }
+
+    return NULL;
+}
+
+static nkView_t *DeepestDirtyMeasureView(nkView_t *view)
+{
+    while (view->childNeedsMeasure)
+    {
+        nkView_t *child = NextQueuedMeasure(view);
+
+        if (child == NULL)
+        {
+            break;
+        }
+
+        view = child;
+    }
+
+    return view;
+}
+
+/* measures dirty views bottom-up, visiting only the paths to them. Each view
+   is re-measured against the constraint it was last measured with; the root
+   takes the given constraint. A view whose sizeRequest comes out unchanged
+   does not dirty its parent. */
+static void MeasureDirtyViews(nkView_t *root, nkSize_t constraint, nkDrawContext_t *context)
+{
+    /* new metrics reach every cached result below through the root's measure */
+    if (!SizeEquals(root->measureCache.constraint, constraint) || !MeasureCurrent(root))
+    {
+        root->needsMeasure = true;
+    }
+
+    if (!root->needsMeasure && !root->childNeedsMeasure)
+    {
+        return;
+    }
+
+    nkView_t *view = DeepestDirtyMeasureView(root);
+
+    while (view)
+    {
+        nkSize_t previousRequest = view->sizeRequest;
+        nkSize_t viewConstraint = (view == root) ? constraint : view->measureCache.constraint;
+
+        view->childNeedsMeasure = false;
+
+        if (view->needsMeasure)
+        {
+            nkView_Measure(view, viewConstraint, context);
+        }
+
+        if (view != root && !SizeEquals(previousRequest, view->sizeRequest))
+        {
+            view->parent->needsMeasure = true;
+            view->parent->needsArrange = true;
+            view->parent->contentVersion++;
+
+            if (view->parent->childChangedCallback)
+            {
+                view->parent->childChangedCallback(view->parent, view);
+            }
+        }
+
+        if (view == root)
+        {
+            break;
+        }
+
+        if (view->needsArrange || view->childNeedsArrange)
+        {
+            view->parent->childNeedsArrange = true;
+        }
+
+        nkView_t *next = NextQueuedMeasure(view->parent);
+
+        view = (next != NULL) ? DeepestDirtyMeasureView(next) : view->parent;
+    }
+}
+
+static void MeasurePass(nkView_t *root, nkSize_t constraint, nkDrawContext_t *context)
+{
+#ifdef NANOVIEW_PARALLEL
+    if (parallelLayout)
+    {
+        parallelMeasureActive = true;
+        MeasureDirtyViewsParallel(root, constraint, context, 0);
+        parallelMeasureActive = false;
+
+        return;
+    }
+#endif
+
+    MeasureDirtyViews(root, constraint, context);
+}
+
+static void BeginMeasureCallback(nkView_t *view)
+{
+#ifdef NANOVIEW_PARALLEL
+    if (parallelMeasureActive && !view->measureThreadSafe)
+    {
+        nkThreadPool_LockSerial();
+    }
+#endif
+}
+
+static void EndMeasureCallback(nkView_t *view)
+{
+#ifdef NANOVIEW_PARALLEL
+    if (parallelMeasureActive && !view->measureThreadSafe)
+    {
+        nkThreadPool_UnlockSerial();
+    }
+#endif
+}
+
+#ifdef NANOVIEW_PARALLEL
+
+/* queued children that still have measure work, counting no further than limit */
+static size_t CountQueuedMeasures(nkView_t *parent, size_t limit)
+{
+    size_t count = 0;
+
+    for (nkView_t *child = parent->measureQueue; child != NULL && count < limit; child = child->nextQueued)
+    {
+        if (child->needsMeasure || child->childNeedsMeasure)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+static void MeasureRangeTask(void *argument)
+{
+    MeasureRange_t *range = (MeasureRange_t *)argument;
+
+    /* pool threads measure text like the thread that started the layout */
+    const nkTextMetrics_t *previousMetrics = textMetrics;
+    textMetrics = range->textMetrics;
+
+    /* counted on this thread, handed back to the one that forked */
+    uint64_t previousCallbacks = stats.layoutCallbacks;
+
+    for (size_t i = 0; i < range->count; i++)
+    {
+        nkView_t *child = range->children[i];
+        nkSize_t previousRequest = child->sizeRequest;
+
+        MeasureDirtyViewsParallel(child, child->measureCache.constraint, range->context, range->depth + 1);
+
+        if (!SizeEquals(previousRequest, child->sizeRequest))
+        {
+            range->resized++;
+
+            /* runs of the same parent may report at once */
+            if (child->parent->childChangedCallback)
+            {
+                nkThreadPool_LockSerial();
+                child->parent->childChangedCallback(child->parent, child);
+                nkThreadPool_UnlockSerial();
+            }
+        }
+
+        if (child->needsArrange || child->childNeedsArrange)
+        {
+            range->needsArrange = true;
+        }
+    }
+
+    textMetrics = previousMetrics;
+
+    range->layoutCallbacks = stats.layoutCallbacks - previousCallbacks;
+    stats.layoutCallbacks = previousCallbacks;
+}
+
+/* same result as MeasureDirtyViews. The children on root's measure queue
+   are split into runs measured concurrently, and their effects on root are
+   folded in after the join so flag and version updates match the serial
+   pass exactly. With fewer than two queued there is nothing to fork. */
+static void MeasureDirtyViewsParallel(nkView_t *root, nkSize_t constraint, nkDrawContext_t *context, size_t depth)
+{
+    size_t dirtyCount = 0;
+    nkView_t **dirty = NULL;
+
+    if (depth < PARALLEL_MAX_FORK_DEPTH && root->childNeedsMeasure && CountQueuedMeasures(root, 2) == 2)
+    {
+        dirtyCount = CountQueuedMeasures(root, SIZE_MAX);
+        dirty = malloc(dirtyCount * sizeof(nkView_t *));
+    }
+
+    if (dirty == NULL)
+    {
+        MeasureDirtyViews(root, constraint, context);
+        return;
+    }
+
+    /* taken off the queue as the serial pass would */
+    for (size_t i = 0; i < dirtyCount; i++)
+    {
+        dirty[i] = NextQueuedMeasure(root);
+    }
+
+    if (!SizeEquals(root->measureCache.constraint, constraint) || !MeasureCurrent(root))
+    {
+        root->needsMeasure = true;
+    }
+
+    size_t rangeCount = 4 * nkThreadPool_ThreadCount();
+
+    if (rangeCount > PARALLEL_MAX_RANGES)
+    {
+        rangeCount = PARALLEL_MAX_RANGES;
+    }
+
+    if (rangeCount > dirtyCount)
+    {
+        rangeCount = dirtyCount;
+    }
+
+    MeasureRange_t ranges[PARALLEL_MAX_RANGES];
+    nkTaskGroup_t group;
+    atomic_init(&group.pending, 0);
+
+    size_t first = 0;
+
+    for (size_t i = 0; i < rangeCount; i++)
+    {
+        /* spread the remainder over the first runs */
+        size_t count = dirtyCount / rangeCount + ((i < dirtyCount % rangeCount) ? 1 : 0);
+
+        ranges[i] = (MeasureRange_t){&dirty[first], count, depth, context, textMetrics, 0, 0, false};
+        first += count;
+
+        if (i > 0)
+        {
+            nkThreadPool_Submit(&group, MeasureRangeTask, &ranges[i]);
+        }
+    }
+
+    MeasureRangeTask(&ranges[0]);
+    nkThreadPool_Wait(&group);
+    free(dirty);
+
+    for (size_t i = 0; i < rangeCount; i++)
+    {
+        stats.layoutCallbacks += ranges[i].layoutCallbacks;
+
+        if (ranges[i].resized > 0)
+        {
+            root->needsMeasure = true;
+            root->needsArrange = true;
+            root->contentVersion += (uint32_t)ranges[i].resized;
+        }
+
+        if (ranges[i].needsArrange)
+        {
+            root->childNeedsArrange = true;
+        }
+    }
+
+    root->childNeedsMeasure = false;
+
+    if (root->needsMeasure)
+    {
+        nkView_Measure(root, constraint, context);
+    }
+}
+
+#endif
+
+static nkView_t *NextDirtyArrangeSibling(nkView_t *view)
+{
+    nkView_t *sibling = view->sibling;
+
+    while (sibling != NULL && !sibling->needsArrange && !sibling->childNeedsArrange)
+    {
+        sibling = sibling->sibling;
+    }
+
+    return sibling;
+}
+
+/* arranges dirty views top-down. Placing a child at a new frame through
+   nkView_PlaceView marks it dirty, so moves cascade only as far as needed. */
+static void ArrangeDirtyViews(nkView_t *root, nkDrawContext_t *context)
+{
+    nkView_t *view = root;
+    bool wasArranging = arranging;
+
+    arranging = true;
+
+    while (view)
+    {
+        /* the frozen arrays are read back from the tree before they are next used */
+        if (view->frozen != NULL && (view->needsArrange || view->childNeedsArrange))
+        {
+            view->frozen->synced = false;
+        }
+
+        if (view->needsArrange)
+        {
+            view->needsArrange = false;
+
+            if (view->arrangeCallback)
+            {
+                stats.layoutCallbacks++;
+
+                PROFILE_BEGIN();
+                view->arrangeCallback(view, context);
+                PROFILE_END(view, NK_PROFILE_ARRANGE);
+            }
+        }
+
+        nkView_t *next = NULL;
+
+        if (view->queryChildrenCallback)
+        {
+            /* children out of sight stay dirty until they are listed */
+            view->childNeedsArrange = false;
+            ArrangeListedChildren(view, context);
+        }
+        else if (view->childNeedsArrange)
+        {
+            view->childNeedsArrange = false;
+
+            next = view->child;
+
+            if (next != NULL && !next->needsArrange && !next->childNeedsArrange)
+            {
+                next = NextDirtyArrangeSibling(next);
+            }
+        }
+
+        /* climb until a dirty sibling is found */
+        while (next == NULL && view != root)
+        {
+            next = NextDirtyArrangeSibling(view);
+            view = view->parent;
+        }
+
+        view = next;
+    }
+
+    arranging = wasArranging;
+}
+
+/* renders the whole tree, or only what overlaps damage if given */
+static void RenderPass(nkView_t *root, const nkRect_t *damage, nkDrawContext_t *context)
+{
+    nkView_t *previous = NULL;
+
+    /* what the root's ancestors let show, the window for a true root */
+    nkRect_t clip = (root->parent != NULL) ? nkView_VisibleRegion(root->parent) : root->frame;
+
+    if (damage != NULL)
+    {
+        clip = RectIntersection(clip, *damage);
+    }
+
+    nkPoint_t translation = nkView_WindowOffset(root);
+
+    renderPassCount++;
+
+    if (occlusionCulling)
+    {
+        occluderCount = 0;
+        minOccluderArea = clip.width * clip.height * MIN_OCCLUDER_SHARE;
+        FindOccluders(root, clip, translation);
+    }
+
+    uint64_t issued = drawBatch.stats.issued;
+
+    nkDrawBatch_Begin(&drawBatch, context);
+
+    RenderSubtree(root, &previous, clip, translation, context);
+
+    RestoreDrawState(previous, root->parent);
+    nkDrawBatch_Flush(&drawBatch);
+
+    stats.drawCalls += drawBatch.stats.issued - issued;
+}
+
+/* render views in a top-down traversal (this is actually bottom up in visual tree 
+   as child views appear on top). clip is the region root may draw into and
+   translation moves its frame into the window; each view leaves its
+   children's in childClip and childTranslation, and subtrees whose bounds
+   miss their clip, or that an occluder hides, are skipped without being
+   saved or restored. previous is the last view rendered. */
+static void RenderSubtree(nkView_t *root, nkView_t **previous, nkRect_t clip, nkPoint_t translation, nkDrawContext_t *context)
+{
+    nkViewIterator_t iterator;
+    nkView_t *view = nkView_PreOrderBegin(&iterator, root);
+
+    while (view)
+    {
+        nkRect_t viewClip = (view == root) ? clip : view->parent->childClip;
+        nkPoint_t viewTranslation = (view == root) ? translation : view->parent->childTranslation;
+
+        if (view->frozen != NULL)
+        {
+            /* sweep the frozen arrays instead of chasing the tree */
+            nkFrozenSubtree_t *frozen = view->frozen;
+
+            for (size_t i = 0; i < frozen->count;)
+            {
+                /* draw callbacks may lay out their own subtree (e.g. scroll views) */
+                if (!frozen->synced)
+                {
+                    SyncFrozen(frozen);
+                }
+
+                nkView_t *member = frozen->views[i];
+                nkRect_t memberClip = (i == 0) ? viewClip : frozen->views[frozen->parents[i]]->childClip;
+                nkPoint_t memberTranslation = {viewTranslation.x + frozen->offsets[i].x, viewTranslation.y + frozen->offsets[i].y};
+
+                if (member->occludedPass == renderPassCount || !RectsOverlap(Translate(SubtreeBounds(member), memberTranslation), memberClip))
+                {
+                    stats.viewsCulled++;
+                    i = frozen->ends[i];
+                    continue;
+                }
+
+                RenderView(member, frozen->frames[i], previous, memberClip, memberTranslation, context);
+                i++;
+            }
+
+            view = nkView_PreOrderSkipChildren(&iterator);
+            continue;
+        }
+
+        if (view->occludedPass == renderPassCount || !RectsOverlap(Translate(SubtreeBounds(view), viewTranslation), viewClip))
+        {
+            stats.viewsCulled++;
+            view = nkView_PreOrderSkipChildren(&iterator);
+            continue;
+        }
+
+        RenderView(view, view->frame, previous, viewClip, viewTranslation, context);
+
+        if (view->childCount >= NK_HIT_INDEX_MIN_CHILDREN && !view->queryChildrenCallback && RenderIndexedChildren(view, previous, context))
+        {
+            view = nkView_PreOrderSkipChildren(&iterator);
+            continue;
+        }
+
+        if (view->queryChildrenCallback)
+        {
+            /* only what can be seen, asked for in the children's coords */
+            nkPoint_t untranslate = {-view->childTranslation.x, -view->childTranslation.y};
+            nkView_t *const *children = NULL;
+            size_t count = view->queryChildrenCallback(view, Translate(view->childClip, untranslate), &children);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                RenderSubtree(children[i], previous, view->childClip, view->childTranslation, context);
+            }
+
+            view = nkView_PreOrderSkipChildren(&iterator);
+            continue;
+        }
+
+        view = nkView_PreOrderNext(&iterator);
+    }
+}
+
+/* Renders the children that can reach the view's childClip, found through
+   its hit index instead of culling every sibling; the view has at least
+   NK_HIT_INDEX_MIN_CHILDREN. A small damage rect over a wide container then
+   visits only the children under it. False, with nothing drawn, if the
+   index can't stand in for the walk, every child is in view, or it would
+   find too many for it to pay. */
+static bool RenderIndexedChildren(nkView_t *view, nkView_t **previous, nkDrawContext_t *context)
+{
+    if (ChildrenSpill(view))
+    {
+        return false;
+    }
+
+    /* with every child in view there's nothing to cull, nor an index to build for it */
+    nkRect_t region = Translate(view->childClip, (nkPoint_t){-view->childTranslation.x, -view->childTranslation.y});
+
+    if (RectContains(region, view->childrenBounds))
+    {
+        return false;
+    }
+
+    nkHitIndex_t *index = PrepareHitIndex(view);
+
+    if (index == NULL)
+    {
+        return false;
+    }
+
+    /* past a quarter of the children, walking them is cheaper */
+    size_t base = renderMatchCount;
+    size_t limit = view->childCount / 4;
+
+    if (base + limit > renderMatchCapacity)
+    {
+        size_t capacity = (renderMatchCapacity > 0) ? renderMatchCapacity * 2 : 256;
+
+        while (capacity < base + limit)
+        {
+            capacity *= 2;
+        }
+
+        nkHitIndexMatch_t *matches = realloc(renderMatches, capacity * sizeof(nkHitIndexMatch_t));
+
+        if (matches == NULL)
+        {
+            return false;
+        }
+
+        renderMatches = matches;
+        renderMatchCapacity = capacity;
+    }
+
+    size_t count = nkHitIndex_Collect(index, region.x, region.y, region.x + region.width, region.y + region.height, renderMatches + base, limit);
+
+    if (count > limit)
+    {
+        return false;
+    }
+
+    renderMatchCount = base + count;
+
+    /* nested calls may move the array, so it's read through each time */
+    for (size_t i = 0; i < count; i++)
+    {
+        RenderSubtree(renderMatches[base + i].view, previous, view->childClip, view->childTranslation, context);
+    }
+
+    renderMatchCount = base;
+
+    return true;
+}
+
+static void ArrangeListedChildren(nkView_t *view, nkDrawContext_t *context)
+{
+    nkView_t *const *children = NULL;
+    size_t count = view->queryChildrenCallback(view, nkView_VisibleChildRegion(view), &children);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (children[i]->needsArrange || children[i]->childNeedsArrange)
+        {
+            ArrangeDirtyViews(children[i], context);
+        }
+    }
+}
+
+/* Walks the views RenderSubtree would visit in reverse draw order, so the
+   occluders held when entering a subtree are all drawn after it. Children
+   are entered from the last, and a view is added as an occluder once its
+   children are done, as it is drawn before them. */
+static void FindOccluders(nkView_t *root, nkRect_t clip, nkPoint_t translation)
+{
+    nkView_t *view = root;
+    bool entered = EnterOccludable(root, clip, translation);
+
+    while (view)
+    {
+        /* down the last children while they need walking */
+        if (entered && view->queryChildrenCallback)
+        {
+            nkPoint_t untranslate = {-view->childTranslation.x, -view->childTranslation.y};
+            nkView_t *const *children = NULL;
+            size_t count = view->queryChildrenCallback(view, Translate(view->childClip, untranslate), &children);
+
+            for (size_t i = count; i > 0; i--)
+            {
+                FindOccluders(children[i - 1], view->childClip, view->childTranslation);
+            }
+        }
+        else if (entered && view->lastChild != NULL)
+        {
+            view = view->lastChild;
+            entered = EnterOccludable(view, view->parent->childClip, view->parent->childTranslation);
+            continue;
+        }
+
+        /* the view's subtree is done, then back along its siblings and up */
+        while (view)
+        {
+            if (entered)
+            {
+                if (view == root)
+                {
+                    AddOccluder(view, clip, translation);
+                }
+                else
+                {
+                    AddOccluder(view, view->parent->childClip, view->parent->childTranslation);
+                }
+            }
+
+            if (view == root)
+            {
+                view = NULL;
+            }
+            else if (view->prevSibling != NULL)
+            {
+                view = view->prevSibling;
+                entered = EnterOccludable(view, view->parent->childClip, view->parent->childTranslation);
+                break;
+            }
+            else
+            {
+                view = view->parent;
+                entered = true; /* its children were walked */
+            }
+        }
+    }
+}
+
+/* sets the region the view's children draw into as RenderView would, or
+   stamps the subtree hidden and returns false if an occluder covers what
+   of it shows. Subtrees outside the clip aren't entered either. */
+static bool EnterOccludable(nkView_t *view, nkRect_t clip, nkPoint_t translation)
+{
+    nkRect_t bounds = Translate(SubtreeBounds(view), translation);
+
+    if (!RectsOverlap(bounds, clip))
+    {
+        return false;
+    }
+
+    bounds = RectIntersection(bounds, clip);
+
+    float area = bounds.width * bounds.height;
+
+    for (size_t i = 0; i < occluderCount && occluders[i].area >= area; i++)
+    {
+        if (RectContains(occluders[i].rect, bounds))
+        {
+            view->occludedPass = renderPassCount;
+            return false;
+        }
+    }
+
+    nkRect_t windowFrame = Translate(view->frame, translation);
+
+    view->childClip = view->clipToBounds ? RectIntersection(clip, windowFrame) : clip;
+    view->childTranslation = (nkPoint_t){translation.x + view->childOffset.x, translation.y + view->childOffset.y};
+
+    return true;
+}
+
+/* keeps an opaque view where it shows if it is among the largest */
+static void AddOccluder(nkView_t *view, nkRect_t clip, nkPoint_t translation)
+{
+    if (!view->opaque && view->backgroundColor.a < 1.0f)
+    {
+        return;
+    }
+
+    nkRect_t rect = RectIntersection(Translate(view->frame, translation), clip);
+    float area = rect.width * rect.height;
+
+    if (area < minOccluderArea || area <= 0.0f)
+    {
+        return;
+    }
+
+    if (occluderCount == MAX_OCCLUDERS)
+    {
+        if (area <= occluders[MAX_OCCLUDERS - 1].area)
+        {
+            return;
+        }
+
+        occluderCount--;
+    }
+
+    size_t i = occluderCount++;
+
+    for (; i > 0 && occluders[i - 1].area < area; i--)
+    {
+        occluders[i] = occluders[i - 1];
+    }
+
+    occluders[i] = (Occluder_t){rect, area};
+}
+
+/* the previous view rendered is inside the parent's subtree, so the views
+   from it up to the parent are exactly those left behind. frame is drawn
+   moved by translation; clips are in window coords. */
+static void RenderView(nkView_t *view, nkRect_t frame, nkView_t **previous, nkRect_t clip, nkPoint_t translation, nkDrawContext_t *context)
+{
+    RestoreDrawState(*previous, view->parent);
+
+    *previous = view;
+    stats.viewsVisited++;
+
+    nkRect_t windowFrame = Translate(frame, translation);
+    bool translated = (translation.x != 0.0f || translation.y != 0.0f);
+
+    view->childClip = view->clipToBounds ? RectIntersection(clip, windowFrame) : clip;
+    view->childTranslation = (nkPoint_t){translation.x + view->childOffset.x, translation.y + view->childOffset.y};
+
+    /* only children overflowing into the clip are visible */
+    if (!RectsOverlap(windowFrame, clip))
+    {
+        return;
+    }
+
+    nkDrawBatch_SetOffset(&drawBatch, translation);
+
+    /* only state the subtree inherits needs saving */
+    if (view->clipToBounds || view->drawChangesState)
+    {
+        stats.saves++;
+        nkDrawBatch_Save(&drawBatch);
+        view->drawStateSaved = true;
+    }
+
+    if (view->clipToBounds)
+    {
+        /* ancestors' clips and the damage must survive clipping views */
+        nkDrawBatch_SetClipRect(&drawBatch, view->childClip);
+    }
+
+    if (view->backgroundColor.a > 0.001f)
+    {
+        nkDrawBatch_SetColor(&drawBatch, view->backgroundColor);
+        nkDrawBatch_Rect(&drawBatch, frame.x, frame.y, frame.width, frame.height);
+    }
+
+    if (view->recordCallback)
+    {
+        PROFILE_BEGIN();
+        DrawRecorded(view, translated, context);
+        PROFILE_END(view, NK_PROFILE_DRAW);
+    }
+    else if (view->drawCallback)
+    {
+        /* the callback draws to the context itself, so sees its window frame */
+        nkDrawBatch_Flush(&drawBatch);
+
+        nkRect_t layoutFrame = view->frame;
+        view->frame = windowFrame;
+
+        stats.drawCallbacks++;
+
+        PROFILE_BEGIN();
+        view->drawCallback(view, context);
+        PROFILE_END(view, NK_PROFILE_DRAW);
+
+        view->frame = layoutFrame;
+
+        nkDrawBatch_Invalidate(&drawBatch);
+    }
+}
+
+/* replays the view's display list, re-recording it first if the view's look
+   changed. Without retained drawing the output is recorded to a scratch list
+   while batching or translated, and otherwise (or without storage) the
+   recording calls draw straight to the context. */
+static void DrawRecorded(nkView_t *view, bool translated, nkDrawContext_t *context)
+{
+    nkDisplayList_t *list = view->displayList;
+
+    if (view->retainDrawing && list == NULL)
+    {
+        list = malloc(sizeof(nkDisplayList_t));
+
+        if (list != NULL)
+        {
+            nkDisplayList_Create(list);
+            view->displayList = list;
+        }
+    }
+
+    if (view->retainDrawing && list != NULL)
+    {
+        if (!list->valid || list->version != view->visualVersion)
+        {
+            nkDisplayList_Clear(list);
+            view->recordCallback(view, list);
+            stats.drawCallbacks++;
+
+            list->version = view->visualVersion;
+            list->valid = list->complete;
+        }
+
+        if (list->valid)
+        {
+            nkDrawBatch_SubmitList(&drawBatch, list);
+            return;
+        }
+    }
+    else if (drawBatch.enabled || translated)
+    {
+        nkDisplayList_Clear(&scratchList);
+        view->recordCallback(view, &scratchList);
+        stats.drawCallbacks++;
+
+        if (scratchList.complete)
+        {
+            nkDrawBatch_SubmitList(&drawBatch, &scratchList);
+            return;
+        }
+    }
+
+    nkDrawBatch_Flush(&drawBatch);
+
+    nkDisplayList_t passthrough;
+    nkDisplayList_Create(&passthrough);
+    passthrough.passthrough = context;
+
+    view->recordCallback(view, &passthrough);
+    stats.drawCallbacks++;
+    stats.drawCalls += passthrough.passedThrough;
+
+    nkDrawBatch_Invalidate(&drawBatch);
+}
+
+/* restores the state saved by from and its ancestors, up to but excluding to */
+static void RestoreDrawState(nkView_t *from, nkView_t *to)
+{
+    for (nkView_t *view = from; view != NULL && view != to; view = view->parent)
+    {
+        if (view->drawStateSaved)
+        {
+            nkDrawBatch_Restore(&drawBatch);
+            view->drawStateSaved = false;
+        }
+    }
+}
+
+/* the recursive hit test returns the eligible view latest in pre-order, so a
+   forward sweep that skips subtrees missing the point finds the same view */
+static nkView_t *HitTestFrozen(nkFrozenSubtree_t *frozen, float x, float y)
+{
+    if (!frozen->synced)
+    {
+        SyncFrozen(frozen);
+    }
+
+    nkView_t *hitView = NULL;
+
+    for (uint32_t i = 0; i < frozen->count;)
+    {
+        nkRect_t frame = Translate(frozen->frames[i], frozen->offsets[i]);
+
+        stats.hitTestViews++;
+
+        bool inView = (
+                (x >= frame.x)
+            &&  (x <= (frame.x + frame.width))
+            &&  (y >= frame.y) 
+            &&  (y <= (frame.y + frame.height))
+        );
+
+        if (!inView)
+        {
+            i = frozen->ends[i];
+            continue;
+        }
+
+        nkView_t *view = frozen->views[i];
+
+        if (view->capturePointerHover || view->capturePointerMovement || view->capturePointerAction)
+        {
+            hitView = view;
+        }
+
+        i++;
+    }
+
+    return hitView;
+}
+
+/* the view's hit index, rebuilt if its children changed and refitted if
+   they moved, or NULL if there is no memory for one */
+static nkHitIndex_t *PrepareHitIndex(nkView_t *view)
+{
+    if (view->hitIndex == NULL)
+    {
+        view->hitIndex = malloc(sizeof(nkHitIndex_t));
+
+        if (view->hitIndex == NULL)
+        {
+            return NULL;
+        }
+
+        nkHitIndex_Create(view->hitIndex);
+    }
+
+    nkHitIndex_t *index = view->hitIndex;
+
+    if (!index->valid || index->structureVersion != view->structureVersion)
+    {
+        return nkHitIndex_Build(index, view) ? index : NULL;
+    }
+
+    if (index->stale)
+    {
+        nkHitIndex_Refit(index);
+    }
+
+    return index;
+}
+
+/* nkView_HitTest(root, x, y), found by walking the last hit's path against
+   the live frames: the views drawn over it, top-down, then its subtree. Only
+   if the point left the path does the whole tree get searched. The walk
+   reads no cached frames, so it is right after any layout or tree edit; the
+   cheaper check for a point that stays put is the memo from BuildHitMemo. */
+static nkView_t *HitTestFromHotView(nkView_t *root, nkView_t *hotView, float x, float y)
+{
+    float pathX = x;
+    float pathY = y;
+    nkView_t *hit = NULL;
+
+    if (FollowHitPath(root, hotView, &pathX, &pathY, &hit))
+    {
+        if (hit == NULL)
+        {
+            hit = nkView_HitTest(hotView, pathX, pathY);
+        }
+
+        if (hit != NULL)
+        {
+            return hit;
+        }
+    }
+
+    return nkView_HitTest(root, x, y);
+}
+
+/* Walks from root down to view the way nkView_HitTest would, leaving x, y in
+   view's parent's child coords. Sets hit if a view drawn over the path takes
+   the point. Returns false if the point is outside a view on the path, or
+   view isn't under root, or the path runs through a frozen subtree. */
+static bool FollowHitPath(nkView_t *root, nkView_t *view, float *x, float *y, nkView_t **hit)
+{
+    if (view == root)
+    {
+        return InFrame(root, *x, *y);
+    }
+
+    nkView_t *parent = view->parent;
+
+    if (parent == NULL || !FollowHitPath(root, parent, x, y, hit))
+    {
+        return false;
+    }
+
+    if (*hit != NULL)
+    {
+        return true;
+    }
+
+    if (parent->frozen != NULL)
+    {
+        return false;
+    }
+
+    *x -= parent->childOffset.x;
+    *y -= parent->childOffset.y;
+
+    /* before the siblings over it, so an index search stops at view */
+    if (!InFrame(view, *x, *y))
+    {
+        return false;
+    }
+
+    return HitTestAbove(parent, view, *x, *y, hit);
+}
+
+/* The first hit among parent's children drawn over child, in the order
+   nkView_HitTest tries them. x, y are in parent's child coords and inside
+   child's frame. Returns false if parent doesn't offer child for hit tests. */
+static bool HitTestAbove(nkView_t *parent, nkView_t *child, float x, float y, nkView_t **hit)
+{
+    if (parent->queryChildrenCallback)
+    {
+        nkView_t *const *children = NULL;
+        size_t count = parent->queryChildrenCallback(parent, (nkRect_t){x, y, 0, 0}, &children);
+
+        for (size_t i = count; i-- > 0;)
+        {
+            if (children[i] == child)
+            {
+                return true;
+            }
+
+            *hit = nkView_HitTest(children[i], x, y);
+
+            if (*hit)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    if (parent->childCount >= NK_HIT_INDEX_MIN_CHILDREN && PrepareHitIndex(parent) != NULL)
+    {
+        /* child holds the point, so the index reaches it before any sibling under it */
+        uint32_t below = UINT32_MAX;
+        uint32_t order;
+        nkView_t *sibling;
+
+        while ((sibling = nkHitIndex_Topmost(parent->hitIndex, x, y, below, &order)) != NULL && sibling != child)
+        {
+            *hit = nkView_HitTest(sibling, x, y);
+
+            if (*hit)
+            {
+                return true;
+            }
+
+            below = order;
+        }
+
+        return true;
+    }
+
+    for (nkView_t *sibling = parent->lastChild; sibling != child; sibling = sibling->prevSibling)
+    {
+        *hit = nkView_HitTest(sibling, x, y);
+
+        if (*hit)
+        {
+            return true;
+        }
+    }
+
+    return true;
+}
+
+/* the hit test's own frame check, edges included */
+static bool InFrame(nkView_t *view, float x, float y)
+{
+    stats.hitTestViews++;
+
+    return x >= view->frame.x
+        && x <= view->frame.x + view->frame.width
+        && y >= view->frame.y
+        && y <= view->frame.y + view->frame.height;
+}
+
+/* built since the last change, even if it came out empty */
+static bool HasHitMemo(nkView_t *root, nkView_t *view)
+{
+    return hitMemo.view == view && hitMemo.root == root && hitMemo.version == hitVersion;
+}
+
+static bool InHitMemo(nkView_t *root, nkView_t *view, float x, float y)
+{
+    return HasHitMemo(root, view)
+        && (view->capturePointerHover || view->capturePointerMovement || view->capturePointerAction)
+        && x >= hitMemo.left && x <= hitMemo.right
+        && y >= hitMemo.top && y <= hitMemo.bottom;
+}
+
+/* Memoizes the part of view's frame where nothing else can take the point:
+   inside every frame on its path, edges excluded, with no view over the path
+   or child of its own reaching in. Frames are compared as the hit test
+   computes them, so the answer is exact. Paths that offset their children,
+   are frozen or let a container list its children get no memo. */
+static void BuildHitMemo(nkView_t *root, nkView_t *view)
+{
+    float left = -INFINITY, top = -INFINITY, right = INFINITY, bottom = INFINITY;
+
+    /* empty until proven, so a failed attempt isn't repeated every move */
+    hitMemo = (HitMemo_t){root, view, hitVersion, INFINITY, INFINITY, -INFINITY, -INFINITY};
+
+    for (nkView_t *node = view;; node = node->parent)
+    {
+        if (node == NULL)
+        {
+            return;
+        }
+
+        left = fmaxf(left, node->frame.x);
+        top = fmaxf(top, node->frame.y);
+        right = fminf(right, node->frame.x + node->frame.width);
+        bottom = fminf(bottom, node->frame.y + node->frame.height);
+
+        if (node == root)
+        {
+            break;
+        }
+
+        nkView_t *parent = node->parent;
+
+        if (parent == NULL || parent->frozen != NULL || parent->queryChildrenCallback
+            || parent->childOffset.x != 0.0f || parent->childOffset.y != 0.0f)
+        {
+            return;
+        }
+    }
+
+    /* neighbours sharing an edge take points on it, so it is left out */
+    left = nextafterf(left, INFINITY);
+    top = nextafterf(top, INFINITY);
+    right = nextafterf(right, -INFINITY);
+    bottom = nextafterf(bottom, -INFINITY);
+
+    /* NaN frames fail here too */
+    if (!(left <= right && top <= bottom))
+    {
+        return;
+    }
+
+    if (view->child != NULL)
+    {
+        if (view->frozen != NULL || view->queryChildrenCallback
+            || view->childOffset.x != 0.0f || view->childOffset.y != 0.0f
+            || ChildrenOverlap(view, NULL, left, top, right, bottom))
+        {
+            return;
+        }
+    }
+
+    for (nkView_t *node = view; node != root; node = node->parent)
+    {
+        if (ChildrenOverlap(node->parent, node, left, top, right, bottom))
+        {
+            return;
+        }
+    }
+
+    hitMemo = (HitMemo_t){root, view, hitVersion, left, top, right, bottom};
+}
+
+/* true if a child of parent drawn over above (any child if NULL) has a frame
+   touching the edges, or if that can't be ruled out */
+static bool ChildrenOverlap(nkView_t *parent, nkView_t *above, float left, float top, float right, float bottom)
+{
+    if (parent->childCount >= NK_HIT_INDEX_MIN_CHILDREN)
+    {
+        nkHitIndex_t *index = PrepareHitIndex(parent);
+
+        return index == NULL || nkHitIndex_Overlaps(index, left, top, right, bottom, above);
+    }
+
+    for (nkView_t *child = parent->lastChild; child != above; child = child->prevSibling)
+    {
+        stats.hitTestViews++;
+
+        if (child->frame.x <= right && child->frame.x + child->frame.width >= left
+            && child->frame.y <= bottom && child->frame.y + child->frame.height >= top)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* the view's frame changed, so neither its parent's index bounds nor the
+   pointer's memo can be trusted */
+static void HitFrameChanged(nkView_t *view)
+{
+    hitVersion++;
+
+    if (view->parent != NULL && view->parent->hitIndex != NULL)
+    {
+        view->parent->hitIndex->stale = true;
+    }
+}
+
+static nkView_t *FrozenAncestor(nkView_t *view)
+{
+    while (view != NULL && view->frozen == NULL)
+    {
+        view = view->parent;
+    }
+
+    return view;
+}
+
+/* structure changes inside a frozen subtree return it to the linked form */
+static void ThawEnclosing(nkView_t *view)
+{
+    nkView_ThawSubtree(FrozenAncestor(view));
+}
+
+static void SyncFrozen(nkFrozenSubtree_t *frozen)
+{
+    for (size_t i = 0; i < frozen->count; i++)
+    {
+        nkView_t *view = frozen->views[i];
+
+        frozen->frames[i] = view->frame;
+
+        /* parents come first in pre-order */
+        if (i == 0)
+        {
+            frozen->offsets[i] = (nkPoint_t){0, 0};
+        }
+        else
+        {
+            uint32_t parent = frozen->parents[i];
+
+            frozen->offsets[i].x = frozen->offsets[parent].x + frozen->views[parent]->childOffset.x;
+            frozen->offsets[i].y = frozen->offsets[parent].y + frozen->views[parent]->childOffset.y;
+        }
+    }
+
+    frozen->synced = true;
+}
+
+/* the view's frame coords of a window point */
+static nkPoint_t ToFrameCoords(nkView_t *view, float x, float y)
+{
+    nkPoint_t offset = nkView_WindowOffset(view);
+
+    return (nkPoint_t){x - offset.x, y - offset.y};
+}
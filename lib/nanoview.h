@@ -24,6 +24,15 @@
 
 #include <nanodraw.h>
 
+#include "nktextmetrics.h"
+#include "nkdamage.h"
+#include "nkdisplaylist.h"
+#include "nkdrawbatch.h"
+
+#ifdef NANOVIEW_PROFILE
+#include "nkprofiler.h"
+#endif
+
 /***************************************************************
 ** MARK: CONSTANTS & MACROS
 ***************************************************************/
@@ -33,6 +42,7 @@
 ***************************************************************/
 
 struct nkView_t; /* forward declaration */
+struct nkFrozenSubtree_t; /* forward declaration */
 
 typedef enum
 {
@@ -58,14 +68,19 @@ typedef enum
     NK_POINTER_ACTION_EXTENDED_2        = 0x05
 } nkPointerAction_t;
 
-typedef void (*ViewMeasureCallback_t)(struct nkView_t *view, nkDrawContext_t *context); 
+typedef void (*ViewMeasureCallback_t)(struct nkView_t *view, nkDrawContext_t *context); /* legacy, writes view->sizeRequest */
+typedef nkSize_t (*ViewMeasureSizeCallback_t)(struct nkView_t *view, nkSize_t available, nkDrawContext_t *context); /* returns desired size */
 typedef void (*ViewArrangeCallback_t)(struct nkView_t *view, nkDrawContext_t *context);
 typedef void (*ViewDrawCallback_t)(struct nkView_t *view, nkDrawContext_t *context);
+typedef void (*ViewRecordCallback_t)(struct nkView_t *view, nkDisplayList_t *list); /* draws through list, see nkView_InvalidateVisual */
 typedef void (*ViewDestroyCallback_t)(struct nkView_t *view); /* called when view is destroyed */
+typedef size_t (*ViewQueryChildrenCallback_t)(struct nkView_t *view, nkRect_t region, struct nkView_t *const **children); /* children that may intersect region, in draw order */
+typedef void (*ViewChildChangedCallback_t)(struct nkView_t *view, struct nkView_t *child); /* child's sizeRequest changed */
+typedef void (*ViewChildListCallback_t)(struct nkView_t *view, struct nkView_t *child, bool added); /* child was just linked in, or is about to be unlinked */
 
 typedef void (*PointerHoverCallback_t)(struct nkView_t *view, nkPointerHover_t event);
-typedef void (*PointerMovementCallback_t)(struct nkView_t *view, float x, float y); /* x, y in window coords */
-typedef void (*PointerActionCallback_t)(struct nkView_t *view, nkPointerAction_t action, nkPointerEvent_t event, float x, float y); /* x, y in window coords */
+typedef void (*PointerMovementCallback_t)(struct nkView_t *view, float x, float y); /* x, y in the view's frame coords */
+typedef void (*PointerActionCallback_t)(struct nkView_t *view, nkPointerAction_t action, nkPointerEvent_t event, float x, float y); /* x, y in the view's frame coords */
 typedef void (*ScrollCallback_t)(struct nkView_t *view, float delta);
 
 typedef enum 
@@ -100,6 +115,34 @@ typedef struct
     size_t ColumnSpan;
 } nkGridLocation_t;
 
+typedef struct
+{
+    nkSize_t constraint; /* available size the result was measured against */
+    nkSize_t result;
+    uint32_t version; /* contentVersion the result was measured at */
+    const struct nkTextMetrics_t *metrics; /* text metrics provider it was measured with, NULL for the draw context */
+    uint32_t metricsGeneration; /* and that provider's generation */
+    bool valid;
+} nkMeasureCache_t;
+
+/* work done by the passes on the calling thread since nkView_ResetStats,
+   see nkView_Stats */
+typedef struct
+{
+    /* rendering */
+    uint64_t viewsVisited; /* views the render passes reached */
+    uint64_t viewsCulled; /* subtrees skipped outside the clip or hidden */
+    uint64_t drawCallbacks; /* drawCallback and recordCallback runs, not replays */
+    uint64_t saves; /* context saves, each restored */
+    uint64_t drawCalls; /* nkDraw calls, but not those drawCallbacks make */
+
+    /* dispatch */
+    uint64_t hitTestViews; /* views whose frame a hit test checked */
+
+    /* layout */
+    uint64_t layoutCallbacks; /* measure and arrange callbacks run */
+} nkViewStats_t;
+
 typedef struct nkView_t
 {    
 
@@ -110,12 +153,21 @@ typedef struct nkView_t
     nkThickness_t margin; 
 
     bool clipToBounds;
+    nkPoint_t childOffset; /* moves the children when drawn and hit tested, but not their frames, see nkView_SetChildOffset */
+    bool drawChangesState; /* drawCallback leaves state its children inherit (transform...), so it is saved */
 
     /* tree structure handles */
     struct nkView_t *parent; /* can be NULL*/
     struct nkView_t *sibling; /* can be NULL*/
     struct nkView_t *prevSibling; /* can be NULL*/
     struct nkView_t *child; /* can be NULL*/
+    struct nkView_t *lastChild; /* can be NULL*/
+    size_t childCount;
+    uint32_t structureVersion; /* bumped whenever the child list changes */
+    size_t containerIndex; /* slot in the parent container's own bookkeeping, e.g. nkCanvasView's index */
+    size_t listingDescendants; /* descendants with a queryChildrenCallback, found again when scrolling reveals their children */
+
+    bool measureThreadSafe; /* measure callbacks touch only the view's own subtree, so may run on a worker thread, see nkView_SetParallelLayout */
 
     /* event capture flags */
     bool capturePointerHover;
@@ -133,22 +185,101 @@ typedef struct nkView_t
     nkRect_t canvasRect;
     
     /* callbacks */
+    ViewMeasureSizeCallback_t measureSizeCallback; /* used in preference to measureCallback */
     ViewMeasureCallback_t measureCallback;
     ViewArrangeCallback_t arrangeCallback;
     ViewDrawCallback_t drawCallback; /* called when view should be drawn */
+    ViewRecordCallback_t recordCallback; /* used in preference to drawCallback */
     ViewDestroyCallback_t destroyCallback; /* called when view is destroyed */
+    ViewQueryChildrenCallback_t queryChildrenCallback; /* if set, arranging, rendering and hit testing only visit the children it lists; set before the view is added */
+    ViewChildChangedCallback_t childChangedCallback; /* called during the measure pass, before this view is measured */
+    ViewChildListCallback_t childListCallback; /* called as each child is added or removed, so containers can track where their list changed */
     PointerHoverCallback_t pointerHoverCallback; /* called when pointer enters and exits the view */
     PointerMovementCallback_t pointerMovementCallback; /* called when pointer moves over the view */
     PointerActionCallback_t pointerActionCallback; /* called when pointer events occur */
     ScrollCallback_t scrollCallback; /* called when scroll events occur */
 
     nkColor_t backgroundColor;
+    bool opaque; /* draws every pixel of its frame without an opaque backgroundColor, see nkView_SetOcclusionCulling */
+
+    /* layout invalidation state, see nkView_InvalidateMeasure */
+    bool needsMeasure; /* sizeRequest must be recomputed */
+    bool needsArrange; /* children must be re-placed */
+    bool childNeedsMeasure; /* a descendant needs measuring */
+    bool childNeedsArrange; /* a descendant needs arranging */
+
+    /* children with measure work, so the measure pass goes straight to them
+       instead of scanning every sibling. A child stays listed until the
+       pass reaches it, and clean ones met there are dropped. */
+    struct nkView_t *measureQueue; /* first listed child */
+    struct nkView_t *nextQueued; /* the parent's next and previous listed children */
+    struct nkView_t *prevQueued;
+    bool queued; /* listed in the parent's measureQueue */
+
+    uint32_t contentVersion; /* bumped whenever the view's measure is invalidated */
+    nkMeasureCache_t measureCache;
+
+    /* damage tracking, see nkView_InvalidateVisual */
+    bool needsRedraw; /* the view's frame must be repainted */
+    bool childNeedsRedraw; /* a descendant has damage */
+    nkRect_t staleBounds; /* also repaint this: frames it moved from, removed children */
+
+    /* retained drawing, see nkView_InvalidateVisual */
+    bool retainDrawing; /* replay recordCallback's output until the view's look changes */
+    uint32_t visualVersion; /* bumped whenever the view's look may have changed */
+    nkDisplayList_t *displayList; /* recorded output, allocated on first use */
+
+    /* visibility culling, see nkView_RenderTree */
+    nkRect_t subtreeBounds; /* frames of the view and what its children can draw over */
+    bool subtreeBoundsValid; /* cleared up the tree when a frame or the structure changes */
+    bool childrenSpill; /* some child's subtree reaches outside the child's frame */
+    nkRect_t childrenBounds; /* union of the children's frames, found with childrenSpill */
+    bool childrenSpillValid; /* cleared with any child's subtreeBoundsValid */
+    uint32_t childrenSpillVersion; /* structureVersion childrenSpill was found for */
+    uint32_t occludedPass; /* set while rendering: the pass that found the subtree hidden, see nkView_SetOcclusionCulling */
+    nkRect_t childClip; /* set while rendering: the region the children draw into */
+    nkPoint_t childTranslation; /* set while rendering: where the children's frame coords put them in the window */
+    bool drawStateSaved; /* set while rendering: the context was saved for this view */
+
+    struct nkFrozenSubtree_t *frozen; /* set on the root of a frozen subtree */
+    struct nkHitIndex_t *hitIndex; /* over the children once there are many, built by the first hit test, see nkhitindex.h */
+
+#ifdef NANOVIEW_PROFILE
+    nkViewProfile_t profile; /* callback timings, see nkprofiler.h */
+#endif
 
     void *data;
     size_t dataSize; /* size of the data in bytes */
 
 } nkView_t;
 
+/* structure-of-arrays copy of a subtree whose structure won't change, in
+   pre-order, read by rendering and hit testing. The subtree of entry i spans
+   [i, ends[i]), so its first child is i + 1 (if i + 1 < ends[i]) and its next
+   sibling is ends[i]. */
+typedef struct nkFrozenSubtree_t
+{
+    size_t count;
+    bool synced; /* false once layout may have moved a view, until the arrays are copied again */
+
+    nkView_t **views;
+    nkRect_t *frames;
+
+    uint32_t *parents; /* index of the parent, the root's is its own */
+    uint32_t *ends; /* one past the last descendant */
+    uint32_t *depths; /* depth below the frozen root */
+    nkPoint_t *offsets; /* child offsets above each entry, from its frame coords to the root's */
+} nkFrozenSubtree_t;
+
+/* bounded tree iterator. Both orders are O(n) over the subtree, as depth is
+   tracked incrementally and no step re-scans a sibling chain. */
+typedef struct
+{
+    nkView_t *root;
+    nkView_t *view; /* current view, NULL once the traversal is done */
+    size_t depth; /* depth of the current view below root */
+} nkViewIterator_t;
+
 
 /***************************************************************
 ** MARK: FUNCTION DEFS
@@ -162,19 +293,150 @@ void nkView_Destroy(nkView_t *view);
 /* VIEW TREE USAGE */
 void nkView_LayoutTree(nkView_t *root, nkSize_t size, nkDrawContext_t *drawContext);
 void nkView_LayoutSubtree(nkView_t *view, nkDrawContext_t *drawContext);
+/* Skips subtrees outside the visible region. The context is only saved
+   around views that clip or set drawChangesState; other views' draw
+   callbacks must set whatever state (color, stroke...) they draw with. */
 void nkView_RenderTree(nkView_t *root, nkDrawContext_t *drawContext);
+/* Moves that stay where hotView was last found over and over again are
+   answered from a memo until a frame, child offset or the tree changes;
+   other moves hit test from hotView's path first, so staying over it costs
+   its depth rather than the tree. While activeView captures pointer actions
+   the pointer is held: hotView keeps its value and nothing is hit tested. */
 void nkView_ProcessPointerMovement(nkView_t *root, float x, float y, nkView_t **hotView, nkView_t *activeView, nkPointerAction_t activeAction);
 void nkView_ProcessPointerAction(nkView_t *root, nkPointerAction_t action, nkPointerEvent_t event, float x, float y, nkView_t *hotView, nkView_t **activeView, nkPointerAction_t *activeAction);
 void nkView_ProcessScroll(nkView_t *root, float delta, nkView_t *hotView);
 
+/* HEADLESS LAYOUT */
+
+/* Lays the tree out without a renderer: views measure text through metrics
+   (see nktextmetrics.h) and callbacks get a NULL draw context, so they must
+   not draw while measuring or arranging. Frames match nkView_LayoutTree
+   whenever metrics agree with the draw context's. */
+void nkView_LayoutTreeHeadless(nkView_t *root, nkSize_t size, const nkTextMetrics_t *metrics);
+
+/* for measure callbacks: measures text with the headless layout's metrics
+   while one is running on this thread, otherwise with nkDraw_MeasureText */
+nkRect_t nkView_MeasureText(nkDrawContext_t *context, nkFont_t *font, const char *text);
+
+/* PARALLEL LAYOUT */
+
+/* Opt-in parallel measure pass, available when built with NANOVIEW_PARALLEL.
+   Dirty sibling subtrees are measured concurrently on a work-stealing pool
+   of threadCount threads (including the caller), joined before their parent
+   is measured. Callbacks of views without measureThreadSafe run under a
+   lock. Results are identical to serial layout. Returns false if parallel
+   layout is unavailable; a threadCount below 2 returns to serial layout. */
+bool nkView_SetParallelLayout(size_t threadCount);
+
+/* PROFILING */
+
+/* Built with NANOVIEW_PROFILE, every measure, arrange and draw callback is
+   timed per view and per view name, see nkprofiler.h. Without it the
+   timing compiles away entirely. */
+
+/* LAYOUT INVALIDATION */
+
+/* Layout is incremental: nkView_LayoutTree only visits views marked dirty
+   and their ancestors. Call these after changing anything that affects a
+   view's measure (text, font, padding...) or arrange (alignment, dock
+   position...). Tree management functions invalidate automatically. */
+void nkView_InvalidateMeasure(nkView_t *view);
+void nkView_InvalidateArrange(nkView_t *view);
+
+/* true if the tree has layout work pending, see nkframescheduler.h */
+bool nkView_NeedsLayout(nkView_t *root);
+
+/* DAMAGE TRACKING */
+
+/* Views are assumed to draw within their frames. A view is damaged when its
+   frame changes, it is added or removed, or it is invalidated here; views
+   whose look depends on other state (colors, highlight...) call this when
+   it changes.
+
+   Views drawing through a recordCallback can also opt in to retained
+   drawing with retainDrawing: their output is recorded once and replayed
+   until the view is invalidated here, its frame changes or its measure is
+   invalidated. */
+void nkView_InvalidateVisual(nkView_t *view);
+void nkView_SetBackgroundColor(nkView_t *view, nkColor_t color); /* invalidates if it changed */
+void nkView_SetClipToBounds(nkView_t *view, bool clipToBounds); /* damages the subtree if it changed */
+
+/* CHILD OFFSETS */
+
+/* Frames are in their parent's frame coords, which are window coords less
+   the childOffset of every ancestor. Moving the children this way (e.g. to
+   scroll them) only damages and redraws what shows, with no layout at all,
+   except that views below with a queryChildrenCallback are marked for arrange
+   so children they reveal are placed by the next layout pass. Draw
+   callbacks see their frame in window coords. */
+void nkView_SetChildOffset(nkView_t *view, nkPoint_t offset);
+
+/* what adds to the view's frame coords to give window coords */
+nkPoint_t nkView_WindowOffset(nkView_t *view);
+
+/* Partial repaint: gathers the damage since the last collection into damage
+   (adding to what it holds) and clears it from the tree. The host keeps the
+   previous frame's pixels, clears the damaged rects if the tree doesn't
+   cover them opaquely, renders with nkView_RenderDamage and presents the
+   rects. nkView_RenderTree repaints everything and leaves the damage alone. */
+void nkView_CollectDamage(nkView_t *root, nkDamageRegion_t *damage);
+
+/* true if the tree has damage not yet collected */
+bool nkView_NeedsRender(nkView_t *root);
+
+/* draws only the views overlapping damage, clipped to it */
+void nkView_RenderDamage(nkView_t *root, nkDrawContext_t *drawContext, const nkDamageRegion_t *damage);
+
+/* DRAW BATCHING */
+
+/* Opt-in: rendering draws through an nkDrawBatch_t (see nkdrawbatch.h),
+   dropping redundant state changes and grouping solid rect fills by colour
+   within each clip. Backgrounds and recordCallback output are batched;
+   the batch is flushed before each drawCallback, whose calls it doesn't
+   see or count. */
+void nkView_SetDrawBatching(bool enabled);
+nkDrawBatchStats_t nkView_DrawBatchStats(void); /* calls saved are submitted - issued */
+void nkView_ResetDrawBatchStats(void);
+
+/* OCCLUSION CULLING */
+
+/* Opt-in: each render pass first walks the tree front to back, keeping the
+   largest opaque views met so far (an opaque backgroundColor, or opaque
+   set), and marks any subtree one of them entirely hides; drawing then
+   skips those. A subtree covered only by several views together is still
+   drawn. Frames must not change while rendering, as the walk comes first. */
+void nkView_SetOcclusionCulling(bool enabled);
+
+/* STATISTICS */
+
+/* Counters kept by nkView_LayoutTree, the render passes and nkView_HitTest
+   at all times; each costs an increment. They are per thread, so read them
+   where the tree is laid out and drawn; parallel measure work is added to
+   the thread that started the layout. Snapshot and reset once per frame
+   for per-frame figures. */
+nkViewStats_t nkView_Stats(void);
+void nkView_ResetStats(void);
+
 /* VIEW TREE MANAGEMENT */
 
 void nkView_AddChildView(nkView_t *parent, nkView_t *child);
-void nkView_RemoveChildView(nkView_t *parent, nkView_t *child);
+void nkView_AddChildViews(nkView_t *parent, nkView_t **children, size_t count); /* appends in array order */
+void nkView_RemoveChildView(nkView_t *parent, nkView_t *child); /* does nothing unless child is parent's */
 void nkView_RemoveView(nkView_t *view);
 void nkView_InsertView(nkView_t *parent, nkView_t *child, nkView_t *before);
 void nkView_ReplaceView(nkView_t *oldView, nkView_t *newView);
 
+/* FROZEN SUBTREES */
+
+/* Compiles a subtree into contiguous arrays (see nkFrozenSubtree_t). Hit
+   testing and rendering over it then run as linear sweeps; layout stays on
+   the linked tree, which visits only dirty paths. Any structure
+   change inside it (add, insert, remove, replace) thaws it automatically.
+   Returns false if the view is inside another frozen subtree, or the subtree
+   holds a view with a queryChildrenCallback. */
+bool nkView_FreezeSubtree(nkView_t *view);
+void nkView_ThawSubtree(nkView_t *view);
+
 /* TREE TRAVERSAL */
 
 nkView_t *nkView_NextViewInTree(nkView_t *view);
@@ -187,10 +449,44 @@ nkView_t *nkView_NextSiblingView(nkView_t *view);
 nkView_t *nkView_PreviousSiblingView(nkView_t *view);
 size_t nkView_GetDepthInTree(nkView_t *view);
 
+/* pre-order visits parents before children, first child first */
+nkView_t *nkView_PreOrderBegin(nkViewIterator_t *iterator, nkView_t *root);
+nkView_t *nkView_PreOrderNext(nkViewIterator_t *iterator);
+nkView_t *nkView_PreOrderSkipChildren(nkViewIterator_t *iterator); /* advances past the current view's subtree */
+
+/* post-order visits children before parents, first child first */
+nkView_t *nkView_PostOrderBegin(nkViewIterator_t *iterator, nkView_t *root);
+nkView_t *nkView_PostOrderNext(nkViewIterator_t *iterator);
+
 /* HIT TESTING */
-nkView_t *nkView_HitTest(nkView_t *view, float x, float y); /* in window co-ordinates */
+nkView_t *nkView_HitTest(nkView_t *view, float x, float y); /* in view's frame co-ordinates, window for a root */
+
+/* the part of the window the view can draw into: its root's frame, cut down
+   by every clipping view on the way (including the view itself), in window
+   coords */
+nkRect_t nkView_VisibleRegion(nkView_t *view);
+
+/* the same region in the frame coords of the view's children, as given to
+   its queryChildrenCallback */
+nkRect_t nkView_VisibleChildRegion(nkView_t *view);
 
 /* LAYOUT */
-void nkView_PlaceView(nkView_t *view, nkRect_t frame); /* places the view at the given frame, applying alignment and margin */
+
+/* measures a view against an available size, returning its desired size and
+   storing it in sizeRequest. Results are cached per (available,
+   contentVersion, text metrics provider and its generation), so containers
+   may call this freely from their measureSizeCallback. Views with only a
+   legacy measureCallback first have any child without a current result
+   measured, against the available size if it was never measured. */
+nkSize_t nkView_Measure(nkView_t *view, nkSize_t available, nkDrawContext_t *context);
+
+/* places the view at the given frame, applying alignment and margin. Outside
+   a layout pass, a move is flagged up to the root for the next one to arrange. */
+void nkView_PlaceView(nkView_t *view, nkRect_t frame);
+
+/* places views[i] at frames[i], with frames bit-identical to calling
+   nkView_PlaceView on each. Uses SSE where available, but fetching the
+   views' fields keeps it no faster, so the containers place one by one. */
+void nkView_PlaceViews(nkView_t **views, const nkRect_t *frames, size_t count);
 
 #endif /* NANOVIEW_H */
\ No newline at end of file
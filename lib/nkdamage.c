@@ -0,0 +1,251 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkdamage.c
+** Module       :  nanoview
+** Author       :  SH
+** Created      :  2025-09-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Damage regions: the parts of the window that
+**                 need repainting, as a short list of rects
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkdamage.h"
+
+#include <stdlib.h>
+#include <math.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static bool IsEmpty(nkRect_t rect);
+static bool Contains(nkRect_t outer, nkRect_t inner);
+static bool Overlaps(nkRect_t a, nkRect_t b);
+static nkRect_t Union(nkRect_t a, nkRect_t b);
+static float Area(nkRect_t rect);
+static void RemoveRect(nkDamageRegion_t *region, size_t index);
+static size_t Subtract(nkRect_t rect, nkRect_t hole, nkRect_t *pieces);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkDamageRegion_Create(nkDamageRegion_t *region)
+{
+    region->count = 0;
+    region->clips = NULL;
+    region->offsets = NULL;
+    region->clipCapacity = 0;
+}
+
+void nkDamageRegion_Destroy(nkDamageRegion_t *region)
+{
+    free(region->clips);
+    free(region->offsets);
+
+    region->clips = NULL;
+    region->offsets = NULL;
+    region->clipCapacity = 0;
+    region->count = 0;
+}
+
+void nkDamageRegion_Clear(nkDamageRegion_t *region)
+{
+    region->count = 0;
+}
+
+void nkDamageRegion_Add(nkDamageRegion_t *region, nkRect_t rect)
+{
+    /* rects still to add; splitting one around a rect it overlaps leaves
+       at most four pieces */
+    nkRect_t pending[4 * NK_DAMAGE_MAX_RECTS + 4];
+    size_t pendingCount = 0;
+
+    pending[pendingCount++] = rect;
+
+    while (pendingCount > 0)
+    {
+        rect = pending[--pendingCount];
+
+        /* merging can make rect reach rects already checked, so start over */
+        for (size_t i = 0; i < region->count && !IsEmpty(rect);)
+        {
+            nkRect_t other = region->rects[i];
+
+            if (!Overlaps(rect, other))
+            {
+                i++;
+                continue;
+            }
+
+            if (Contains(other, rect))
+            {
+                rect = (nkRect_t){0, 0, 0, 0};
+                break;
+            }
+
+            nkRect_t merged = Union(rect, other);
+
+            if (Contains(rect, other) || Area(merged) <= Area(rect) + Area(other))
+            {
+                RemoveRect(region, i);
+                rect = merged;
+                i = 0;
+                continue;
+            }
+
+            if (pendingCount + 4 > sizeof(pending) / sizeof(pending[0]))
+            {
+                break;
+            }
+
+            pendingCount += Subtract(rect, other, &pending[pendingCount]);
+            rect = (nkRect_t){0, 0, 0, 0};
+        }
+
+        if (IsEmpty(rect))
+        {
+            continue;
+        }
+
+        if (region->count == NK_DAMAGE_MAX_RECTS || pendingCount + 4 > sizeof(pending) / sizeof(pending[0]))
+        {
+            /* too fragmented: one rect around everything */
+            nkRect_t bounds = Union(nkDamageRegion_Bounds(region), rect);
+
+            for (size_t i = 0; i < pendingCount; i++)
+            {
+                bounds = Union(bounds, pending[i]);
+            }
+
+            region->rects[0] = bounds;
+            region->count = 1;
+            return;
+        }
+
+        region->rects[region->count++] = rect;
+    }
+}
+
+nkRect_t nkDamageRegion_Bounds(const nkDamageRegion_t *region)
+{
+    if (region->count == 0)
+    {
+        return (nkRect_t){0, 0, 0, 0};
+    }
+
+    nkRect_t bounds = region->rects[0];
+
+    for (size_t i = 1; i < region->count; i++)
+    {
+        bounds = Union(bounds, region->rects[i]);
+    }
+
+    return bounds;
+}
+
+bool nkDamageRegion_Intersects(const nkDamageRegion_t *region, nkRect_t rect)
+{
+    for (size_t i = 0; i < region->count; i++)
+    {
+        if (Overlaps(region->rects[i], rect))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static bool IsEmpty(nkRect_t rect)
+{
+    return !(rect.width > 0.0f && rect.height > 0.0f);
+}
+
+static bool Contains(nkRect_t outer, nkRect_t inner)
+{
+    return inner.x >= outer.x && inner.y >= outer.y &&
+        inner.x + inner.width <= outer.x + outer.width &&
+        inner.y + inner.height <= outer.y + outer.height;
+}
+
+static bool Overlaps(nkRect_t a, nkRect_t b)
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+        a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+static nkRect_t Union(nkRect_t a, nkRect_t b)
+{
+    float left = fminf(a.x, b.x);
+    float top = fminf(a.y, b.y);
+    float right = fmaxf(a.x + a.width, b.x + b.width);
+    float bottom = fmaxf(a.y + a.height, b.y + b.height);
+
+    return (nkRect_t){left, top, right - left, bottom - top};
+}
+
+static float Area(nkRect_t rect)
+{
+    return rect.width * rect.height;
+}
+
+/* order doesn't matter, the last rect fills the gap */
+static void RemoveRect(nkDamageRegion_t *region, size_t index)
+{
+    region->rects[index] = region->rects[--region->count];
+}
+
+/* the parts of rect outside hole, as up to four rects: the full-width bands
+   above and below it, then the parts either side */
+static size_t Subtract(nkRect_t rect, nkRect_t hole, nkRect_t *pieces)
+{
+    float top = fmaxf(rect.y, hole.y);
+    float bottom = fminf(rect.y + rect.height, hole.y + hole.height);
+    size_t count = 0;
+
+    if (hole.y > rect.y)
+    {
+        pieces[count++] = (nkRect_t){rect.x, rect.y, rect.width, hole.y - rect.y};
+    }
+
+    if (hole.y + hole.height < rect.y + rect.height)
+    {
+        pieces[count++] = (nkRect_t){rect.x, bottom, rect.width, rect.y + rect.height - bottom};
+    }
+
+    if (hole.x > rect.x)
+    {
+        pieces[count++] = (nkRect_t){rect.x, top, hole.x - rect.x, bottom - top};
+    }
+
+    if (hole.x + hole.width < rect.x + rect.width)
+    {
+        pieces[count++] = (nkRect_t){hole.x + hole.width, top, rect.x + rect.width - hole.x - hole.width, bottom - top};
+    }
+
+    return count;
+}
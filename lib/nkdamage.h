@@ -0,0 +1,68 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkdamage.h
+** Module       :  nanoview
+** Author       :  SH
+** Created      :  2025-09-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Damage regions: the parts of the window that
+**                 need repainting, as a short list of rects
+**
+***************************************************************/
+
+#ifndef NKDAMAGE_H
+#define NKDAMAGE_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <nanodraw.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_DAMAGE_MAX_RECTS 8 /* beyond this, the region becomes the one rect around it */
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    nkRect_t rects[NK_DAMAGE_MAX_RECTS]; /* disjoint, so no pixel is repainted twice */
+    size_t count;
+
+    /* working storage for the damage walk, see nkView_CollectDamage */
+    nkRect_t *clips;
+    nkPoint_t *offsets;
+    size_t clipCapacity;
+} nkDamageRegion_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+void nkDamageRegion_Create(nkDamageRegion_t *region);
+void nkDamageRegion_Destroy(nkDamageRegion_t *region);
+
+void nkDamageRegion_Clear(nkDamageRegion_t *region);
+
+/* Adds rect, merging it with a rect it overlaps when their union covers no
+   more than the two did apart, and otherwise adding only the parts not yet
+   covered. Empty rects are ignored. */
+void nkDamageRegion_Add(nkDamageRegion_t *region, nkRect_t rect);
+
+/* smallest rect holding the whole region, empty if there is none */
+nkRect_t nkDamageRegion_Bounds(const nkDamageRegion_t *region);
+
+bool nkDamageRegion_Intersects(const nkDamageRegion_t *region, nkRect_t rect);
+
+#endif /* NKDAMAGE_H */
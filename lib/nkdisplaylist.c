@@ -0,0 +1,343 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkdisplaylist.c
+** Module       :  nanoview
+** Author       :  SH
+** Created      :  2025-09-19 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Display lists: a view's draw calls recorded
+**                 once and replayed until its look changes
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkdisplaylist.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define INITIAL_COMMAND_CAPACITY 8
+#define INITIAL_TEXT_CAPACITY 64
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static nkDrawCommand_t *Append(nkDisplayList_t *list, nkDrawCommandType_t type);
+static void SetGradient(nkDisplayList_t *list, nkDrawCommandType_t type, nkColor_t start, nkColor_t end, float angle, float x, float y, float width, float height);
+static void Shape(nkDisplayList_t *list, nkDrawCommandType_t type, float x, float y, float width, float height, float radius);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkDisplayList_Create(nkDisplayList_t *list)
+{
+    list->commands = NULL;
+    list->count = 0;
+    list->capacity = 0;
+
+    list->text = NULL;
+    list->textSize = 0;
+    list->textCapacity = 0;
+
+    list->complete = true;
+
+    list->version = 0;
+    list->valid = false;
+
+    list->passthrough = NULL;
+    list->passedThrough = 0;
+}
+
+void nkDisplayList_Destroy(nkDisplayList_t *list)
+{
+    free(list->commands);
+    free(list->text);
+
+    nkDisplayList_Create(list);
+}
+
+void nkDisplayList_Clear(nkDisplayList_t *list)
+{
+    list->count = 0;
+    list->textSize = 0;
+    list->complete = true;
+    list->valid = false;
+}
+
+void nkDisplayList_Replay(const nkDisplayList_t *list, nkDrawContext_t *context)
+{
+    for (size_t i = 0; i < list->count; i++)
+    {
+        const nkDrawCommand_t *command = &list->commands[i];
+
+        switch (command->type)
+        {
+            case NK_DRAW_COMMAND_SET_COLOR:
+            {
+                nkDraw_SetColor(context, command->color);
+            } break;
+
+            case NK_DRAW_COMMAND_SET_COLOR_GRADIENT:
+            {
+                nkDraw_SetColorGradient(
+                    context, command->gradient.start, command->gradient.end, command->gradient.angle,
+                    command->gradient.rect.x, command->gradient.rect.y,
+                    command->gradient.rect.width, command->gradient.rect.height
+                );
+            } break;
+
+            case NK_DRAW_COMMAND_SET_STROKE_COLOR_GRADIENT:
+            {
+                nkDraw_SetStrokeColorGradient(
+                    context, command->gradient.start, command->gradient.end, command->gradient.angle,
+                    command->gradient.rect.x, command->gradient.rect.y,
+                    command->gradient.rect.width, command->gradient.rect.height
+                );
+            } break;
+
+            case NK_DRAW_COMMAND_SET_STROKE_WIDTH:
+            {
+                nkDraw_SetStrokeWidth(context, command->width);
+            } break;
+
+            case NK_DRAW_COMMAND_RECT:
+            {
+                nkDraw_Rect(context, command->shape.rect.x, command->shape.rect.y, command->shape.rect.width, command->shape.rect.height);
+            } break;
+
+            case NK_DRAW_COMMAND_ROUNDED_RECT:
+            {
+                nkDraw_RoundedRect(context, command->shape.rect.x, command->shape.rect.y, command->shape.rect.width, command->shape.rect.height, command->shape.radius);
+            } break;
+
+            case NK_DRAW_COMMAND_ROUNDED_RECT_PATH:
+            {
+                nkDraw_RoundedRectPath(context, command->shape.rect.x, command->shape.rect.y, command->shape.rect.width, command->shape.rect.height, command->shape.radius);
+            } break;
+
+            case NK_DRAW_COMMAND_TEXT:
+            {
+                nkDraw_Text(context, command->text.font, list->text + command->text.offset, command->text.x, command->text.y);
+            } break;
+        }
+    }
+}
+
+void nkDisplayList_SetColor(nkDisplayList_t *list, nkColor_t color)
+{
+    if (list->passthrough != NULL)
+    {
+        nkDraw_SetColor(list->passthrough, color);
+        list->passedThrough++;
+        return;
+    }
+
+    nkDrawCommand_t *command = Append(list, NK_DRAW_COMMAND_SET_COLOR);
+
+    if (command != NULL)
+    {
+        command->color = color;
+    }
+}
+
+void nkDisplayList_SetColorGradient(nkDisplayList_t *list, nkColor_t start, nkColor_t end, float angle, float x, float y, float width, float height)
+{
+    if (list->passthrough != NULL)
+    {
+        nkDraw_SetColorGradient(list->passthrough, start, end, angle, x, y, width, height);
+        list->passedThrough++;
+        return;
+    }
+
+    SetGradient(list, NK_DRAW_COMMAND_SET_COLOR_GRADIENT, start, end, angle, x, y, width, height);
+}
+
+void nkDisplayList_SetStrokeColorGradient(nkDisplayList_t *list, nkColor_t start, nkColor_t end, float angle, float x, float y, float width, float height)
+{
+    if (list->passthrough != NULL)
+    {
+        nkDraw_SetStrokeColorGradient(list->passthrough, start, end, angle, x, y, width, height);
+        list->passedThrough++;
+        return;
+    }
+
+    SetGradient(list, NK_DRAW_COMMAND_SET_STROKE_COLOR_GRADIENT, start, end, angle, x, y, width, height);
+}
+
+void nkDisplayList_SetStrokeWidth(nkDisplayList_t *list, float width)
+{
+    if (list->passthrough != NULL)
+    {
+        nkDraw_SetStrokeWidth(list->passthrough, width);
+        list->passedThrough++;
+        return;
+    }
+
+    nkDrawCommand_t *command = Append(list, NK_DRAW_COMMAND_SET_STROKE_WIDTH);
+
+    if (command != NULL)
+    {
+        command->width = width;
+    }
+}
+
+void nkDisplayList_Rect(nkDisplayList_t *list, float x, float y, float width, float height)
+{
+    if (list->passthrough != NULL)
+    {
+        nkDraw_Rect(list->passthrough, x, y, width, height);
+        list->passedThrough++;
+        return;
+    }
+
+    Shape(list, NK_DRAW_COMMAND_RECT, x, y, width, height, 0.0f);
+}
+
+void nkDisplayList_RoundedRect(nkDisplayList_t *list, float x, float y, float width, float height, float radius)
+{
+    if (list->passthrough != NULL)
+    {
+        nkDraw_RoundedRect(list->passthrough, x, y, width, height, radius);
+        list->passedThrough++;
+        return;
+    }
+
+    Shape(list, NK_DRAW_COMMAND_ROUNDED_RECT, x, y, width, height, radius);
+}
+
+void nkDisplayList_RoundedRectPath(nkDisplayList_t *list, float x, float y, float width, float height, float radius)
+{
+    if (list->passthrough != NULL)
+    {
+        nkDraw_RoundedRectPath(list->passthrough, x, y, width, height, radius);
+        list->passedThrough++;
+        return;
+    }
+
+    Shape(list, NK_DRAW_COMMAND_ROUNDED_RECT_PATH, x, y, width, height, radius);
+}
+
+void nkDisplayList_Text(nkDisplayList_t *list, nkFont_t *font, const char *text, float x, float y)
+{
+    if (list->passthrough != NULL)
+    {
+        nkDraw_Text(list->passthrough, font, text, x, y);
+        list->passedThrough++;
+        return;
+    }
+
+    if (text == NULL)
+    {
+        return;
+    }
+
+    size_t length = strlen(text) + 1;
+
+    if (list->textSize + length > list->textCapacity)
+    {
+        size_t capacity = (list->textCapacity > 0) ? list->textCapacity : INITIAL_TEXT_CAPACITY;
+
+        while (capacity < list->textSize + length)
+        {
+            capacity *= 2;
+        }
+
+        char *storage = realloc(list->text, capacity);
+
+        if (storage == NULL)
+        {
+            list->complete = false;
+            return;
+        }
+
+        list->text = storage;
+        list->textCapacity = capacity;
+    }
+
+    nkDrawCommand_t *command = Append(list, NK_DRAW_COMMAND_TEXT);
+
+    if (command == NULL)
+    {
+        return;
+    }
+
+    memcpy(list->text + list->textSize, text, length);
+
+    command->text.font = font;
+    command->text.offset = list->textSize;
+    command->text.x = x;
+    command->text.y = y;
+
+    list->textSize += length;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+/* NULL, and the list marked incomplete, if storage runs out */
+static nkDrawCommand_t *Append(nkDisplayList_t *list, nkDrawCommandType_t type)
+{
+    if (list->count == list->capacity)
+    {
+        size_t capacity = (list->capacity > 0) ? list->capacity * 2 : INITIAL_COMMAND_CAPACITY;
+        nkDrawCommand_t *commands = realloc(list->commands, capacity * sizeof(nkDrawCommand_t));
+
+        if (commands == NULL)
+        {
+            list->complete = false;
+            return NULL;
+        }
+
+        list->commands = commands;
+        list->capacity = capacity;
+    }
+
+    nkDrawCommand_t *command = &list->commands[list->count++];
+    command->type = type;
+
+    return command;
+}
+
+static void SetGradient(nkDisplayList_t *list, nkDrawCommandType_t type, nkColor_t start, nkColor_t end, float angle, float x, float y, float width, float height)
+{
+    nkDrawCommand_t *command = Append(list, type);
+
+    if (command != NULL)
+    {
+        command->gradient.start = start;
+        command->gradient.end = end;
+        command->gradient.angle = angle;
+        command->gradient.rect = (nkRect_t){x, y, width, height};
+    }
+}
+
+static void Shape(nkDisplayList_t *list, nkDrawCommandType_t type, float x, float y, float width, float height, float radius)
+{
+    nkDrawCommand_t *command = Append(list, type);
+
+    if (command != NULL)
+    {
+        command->shape.rect = (nkRect_t){x, y, width, height};
+        command->shape.radius = radius;
+    }
+}
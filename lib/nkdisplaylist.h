@@ -0,0 +1,124 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkdisplaylist.h
+** Module       :  nanoview
+** Author       :  SH
+** Created      :  2025-09-19 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Display lists: a view's draw calls recorded
+**                 once and replayed until its look changes
+**
+***************************************************************/
+
+#ifndef NKDISPLAYLIST_H
+#define NKDISPLAYLIST_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <nanodraw.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef enum
+{
+    NK_DRAW_COMMAND_SET_COLOR,
+    NK_DRAW_COMMAND_SET_COLOR_GRADIENT,
+    NK_DRAW_COMMAND_SET_STROKE_COLOR_GRADIENT,
+    NK_DRAW_COMMAND_SET_STROKE_WIDTH,
+    NK_DRAW_COMMAND_RECT,
+    NK_DRAW_COMMAND_ROUNDED_RECT,
+    NK_DRAW_COMMAND_ROUNDED_RECT_PATH,
+    NK_DRAW_COMMAND_TEXT
+} nkDrawCommandType_t;
+
+/* one nkDraw call and its arguments */
+typedef struct
+{
+    nkDrawCommandType_t type;
+
+    union
+    {
+        nkColor_t color;
+        float width;
+
+        struct
+        {
+            nkRect_t rect;
+            float radius;
+        } shape;
+
+        struct
+        {
+            nkColor_t start;
+            nkColor_t end;
+            float angle;
+            nkRect_t rect;
+        } gradient;
+
+        struct
+        {
+            nkFont_t *font;
+            size_t offset; /* into the list's text storage */
+            float x;
+            float y;
+        } text;
+    };
+} nkDrawCommand_t;
+
+typedef struct
+{
+    nkDrawCommand_t *commands;
+    size_t count;
+    size_t capacity;
+
+    char *text; /* copies of the strings drawn, so callers needn't keep them */
+    size_t textSize;
+    size_t textCapacity;
+
+    bool complete; /* false if storage ran out while recording */
+
+    uint32_t version; /* owner's tag for what was recorded */
+    bool valid;
+
+    nkDrawContext_t *passthrough; /* if set, calls draw to it instead of recording */
+    size_t passedThrough; /* calls drawn to passthrough */
+} nkDisplayList_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+void nkDisplayList_Create(nkDisplayList_t *list);
+void nkDisplayList_Destroy(nkDisplayList_t *list);
+
+/* empties the list for recording, keeping its storage */
+void nkDisplayList_Clear(nkDisplayList_t *list);
+
+/* issues the recorded calls in order */
+void nkDisplayList_Replay(const nkDisplayList_t *list, nkDrawContext_t *context);
+
+/* RECORDING, each the same as its nkDraw counterpart */
+void nkDisplayList_SetColor(nkDisplayList_t *list, nkColor_t color);
+void nkDisplayList_SetColorGradient(nkDisplayList_t *list, nkColor_t start, nkColor_t end, float angle, float x, float y, float width, float height);
+void nkDisplayList_SetStrokeColorGradient(nkDisplayList_t *list, nkColor_t start, nkColor_t end, float angle, float x, float y, float width, float height);
+void nkDisplayList_SetStrokeWidth(nkDisplayList_t *list, float width);
+void nkDisplayList_Rect(nkDisplayList_t *list, float x, float y, float width, float height);
+void nkDisplayList_RoundedRect(nkDisplayList_t *list, float x, float y, float width, float height, float radius);
+void nkDisplayList_RoundedRectPath(nkDisplayList_t *list, float x, float y, float width, float height, float radius);
+void nkDisplayList_Text(nkDisplayList_t *list, nkFont_t *font, const char *text, float x, float y);
+
+#endif /* NKDISPLAYLIST_H */
@@ -0,0 +1,420 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkdrawbatch.c
+** Module       :  nanoview
+** Author       :  SH
+** Created      :  2025-09-20 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Draw batching: a layer in front of nkDraw that
+**                 drops redundant state changes and groups solid
+**                 rect fills by colour
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkdrawbatch.h"
+
+#include <string.h>
+#include <math.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static bool ColorEquals(nkColor_t a, nkColor_t b);
+static bool Contains(nkRect_t outer, nkRect_t inner);
+static bool Overlaps(nkRect_t a, nkRect_t b);
+static bool JoinAdjacent(nkRect_t a, nkRect_t b, nkRect_t *joined);
+
+static void IssueColor(nkDrawBatch_t *batch, nkColor_t color);
+static void Sync(nkDrawBatch_t *batch);
+static void AddFill(nkDrawBatch_t *batch, nkRect_t rect);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkDrawBatch_Create(nkDrawBatch_t *batch)
+{
+    memset(batch, 0, sizeof(nkDrawBatch_t));
+}
+
+void nkDrawBatch_Begin(nkDrawBatch_t *batch, nkDrawContext_t *context)
+{
+    batch->context = context;
+    batch->fillCount = 0;
+    batch->offset = (nkPoint_t){0, 0};
+
+    nkDrawBatch_Invalidate(batch);
+}
+
+void nkDrawBatch_Flush(nkDrawBatch_t *batch)
+{
+    for (size_t i = 0; i < batch->fillCount; i++)
+    {
+        nkRect_t rect = batch->fills[i].rect;
+
+        IssueColor(batch, batch->fills[i].color);
+        nkDraw_Rect(batch->context, rect.x, rect.y, rect.width, rect.height);
+        batch->stats.issued++;
+    }
+
+    batch->fillCount = 0;
+}
+
+void nkDrawBatch_Invalidate(nkDrawBatch_t *batch)
+{
+    batch->colorIsFill = false;
+    batch->issuedColorKnown = false;
+    batch->issuedStrokeWidthKnown = false;
+}
+
+void nkDrawBatch_Save(nkDrawBatch_t *batch)
+{
+    batch->stats.submitted++;
+
+    nkDrawBatch_Flush(batch);
+    nkDraw_SaveContext(batch->context);
+    batch->stats.issued++;
+}
+
+void nkDrawBatch_Restore(nkDrawBatch_t *batch)
+{
+    batch->stats.submitted++;
+
+    nkDrawBatch_Flush(batch);
+    nkDraw_RestoreContext(batch->context);
+    batch->stats.issued++;
+
+    /* back to whatever was saved */
+    nkDrawBatch_Invalidate(batch);
+}
+
+void nkDrawBatch_SetClipRect(nkDrawBatch_t *batch, nkRect_t rect)
+{
+    batch->stats.submitted++;
+
+    nkDrawBatch_Flush(batch);
+    nkDraw_SetClipRect(batch->context, rect);
+    batch->stats.issued++;
+}
+
+void nkDrawBatch_SetOffset(nkDrawBatch_t *batch, nkPoint_t offset)
+{
+    batch->offset = offset;
+}
+
+void nkDrawBatch_SetColor(nkDrawBatch_t *batch, nkColor_t color)
+{
+    batch->stats.submitted++;
+
+    if (!batch->enabled)
+    {
+        nkDraw_SetColor(batch->context, color);
+        batch->stats.issued++;
+        return;
+    }
+
+    /* issued when something draws with it */
+    batch->color = color;
+    batch->colorIsFill = true;
+}
+
+void nkDrawBatch_SetColorGradient(nkDrawBatch_t *batch, nkColor_t start, nkColor_t end, float angle, float x, float y, float width, float height)
+{
+    batch->stats.submitted++;
+
+    x += batch->offset.x;
+    y += batch->offset.y;
+
+    Sync(batch);
+    nkDraw_SetColorGradient(batch->context, start, end, angle, x, y, width, height);
+    batch->stats.issued++;
+
+    batch->colorIsFill = false;
+    batch->issuedColorKnown = false;
+}
+
+void nkDrawBatch_SetStrokeColorGradient(nkDrawBatch_t *batch, nkColor_t start, nkColor_t end, float angle, float x, float y, float width, float height)
+{
+    batch->stats.submitted++;
+
+    x += batch->offset.x;
+    y += batch->offset.y;
+
+    Sync(batch);
+    nkDraw_SetStrokeColorGradient(batch->context, start, end, angle, x, y, width, height);
+    batch->stats.issued++;
+
+    /* in case the backend shares colour state between fill and stroke */
+    batch->issuedColorKnown = false;
+}
+
+void nkDrawBatch_SetStrokeWidth(nkDrawBatch_t *batch, float width)
+{
+    batch->stats.submitted++;
+
+    if (batch->enabled && batch->issuedStrokeWidthKnown && batch->issuedStrokeWidth == width)
+    {
+        return;
+    }
+
+    Sync(batch);
+    nkDraw_SetStrokeWidth(batch->context, width);
+    batch->stats.issued++;
+
+    batch->issuedStrokeWidth = width;
+    batch->issuedStrokeWidthKnown = true;
+}
+
+void nkDrawBatch_Rect(nkDrawBatch_t *batch, float x, float y, float width, float height)
+{
+    batch->stats.submitted++;
+
+    x += batch->offset.x;
+    y += batch->offset.y;
+
+    if (batch->enabled && batch->colorIsFill)
+    {
+        AddFill(batch, (nkRect_t){x, y, width, height});
+        return;
+    }
+
+    Sync(batch);
+    nkDraw_Rect(batch->context, x, y, width, height);
+    batch->stats.issued++;
+}
+
+void nkDrawBatch_RoundedRect(nkDrawBatch_t *batch, float x, float y, float width, float height, float radius)
+{
+    batch->stats.submitted++;
+
+    x += batch->offset.x;
+    y += batch->offset.y;
+
+    Sync(batch);
+    nkDraw_RoundedRect(batch->context, x, y, width, height, radius);
+    batch->stats.issued++;
+}
+
+void nkDrawBatch_RoundedRectPath(nkDrawBatch_t *batch, float x, float y, float width, float height, float radius)
+{
+    batch->stats.submitted++;
+
+    x += batch->offset.x;
+    y += batch->offset.y;
+
+    Sync(batch);
+    nkDraw_RoundedRectPath(batch->context, x, y, width, height, radius);
+    batch->stats.issued++;
+}
+
+void nkDrawBatch_Text(nkDrawBatch_t *batch, nkFont_t *font, const char *text, float x, float y)
+{
+    batch->stats.submitted++;
+
+    x += batch->offset.x;
+    y += batch->offset.y;
+
+    Sync(batch);
+    nkDraw_Text(batch->context, font, text, x, y);
+    batch->stats.issued++;
+}
+
+void nkDrawBatch_SubmitList(nkDrawBatch_t *batch, const nkDisplayList_t *list)
+{
+    for (size_t i = 0; i < list->count; i++)
+    {
+        const nkDrawCommand_t *command = &list->commands[i];
+
+        switch (command->type)
+        {
+            case NK_DRAW_COMMAND_SET_COLOR:
+            {
+                nkDrawBatch_SetColor(batch, command->color);
+            } break;
+
+            case NK_DRAW_COMMAND_SET_COLOR_GRADIENT:
+            {
+                nkDrawBatch_SetColorGradient(
+                    batch, command->gradient.start, command->gradient.end, command->gradient.angle,
+                    command->gradient.rect.x, command->gradient.rect.y,
+                    command->gradient.rect.width, command->gradient.rect.height
+                );
+            } break;
+
+            case NK_DRAW_COMMAND_SET_STROKE_COLOR_GRADIENT:
+            {
+                nkDrawBatch_SetStrokeColorGradient(
+                    batch, command->gradient.start, command->gradient.end, command->gradient.angle,
+                    command->gradient.rect.x, command->gradient.rect.y,
+                    command->gradient.rect.width, command->gradient.rect.height
+                );
+            } break;
+
+            case NK_DRAW_COMMAND_SET_STROKE_WIDTH:
+            {
+                nkDrawBatch_SetStrokeWidth(batch, command->width);
+            } break;
+
+            case NK_DRAW_COMMAND_RECT:
+            {
+                nkDrawBatch_Rect(batch, command->shape.rect.x, command->shape.rect.y, command->shape.rect.width, command->shape.rect.height);
+            } break;
+
+            case NK_DRAW_COMMAND_ROUNDED_RECT:
+            {
+                nkDrawBatch_RoundedRect(batch, command->shape.rect.x, command->shape.rect.y, command->shape.rect.width, command->shape.rect.height, command->shape.radius);
+            } break;
+
+            case NK_DRAW_COMMAND_ROUNDED_RECT_PATH:
+            {
+                nkDrawBatch_RoundedRectPath(batch, command->shape.rect.x, command->shape.rect.y, command->shape.rect.width, command->shape.rect.height, command->shape.radius);
+            } break;
+
+            case NK_DRAW_COMMAND_TEXT:
+            {
+                nkDrawBatch_Text(batch, command->text.font, list->text + command->text.offset, command->text.x, command->text.y);
+            } break;
+        }
+    }
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static bool ColorEquals(nkColor_t a, nkColor_t b)
+{
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+static bool Contains(nkRect_t outer, nkRect_t inner)
+{
+    return inner.x >= outer.x && inner.y >= outer.y &&
+        inner.x + inner.width <= outer.x + outer.width &&
+        inner.y + inner.height <= outer.y + outer.height;
+}
+
+static bool Overlaps(nkRect_t a, nkRect_t b)
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+        a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+/* true if a and b share a whole edge, so together they are one rect */
+static bool JoinAdjacent(nkRect_t a, nkRect_t b, nkRect_t *joined)
+{
+    if (a.y == b.y && a.height == b.height && (a.x + a.width == b.x || b.x + b.width == a.x))
+    {
+        *joined = (nkRect_t){fminf(a.x, b.x), a.y, a.width + b.width, a.height};
+        return true;
+    }
+
+    if (a.x == b.x && a.width == b.width && (a.y + a.height == b.y || b.y + b.height == a.y))
+    {
+        *joined = (nkRect_t){a.x, fminf(a.y, b.y), a.width, a.height + b.height};
+        return true;
+    }
+
+    return false;
+}
+
+static void IssueColor(nkDrawBatch_t *batch, nkColor_t color)
+{
+    if (batch->issuedColorKnown && ColorEquals(batch->issuedColor, color))
+    {
+        return;
+    }
+
+    nkDraw_SetColor(batch->context, color);
+    batch->stats.issued++;
+
+    batch->issuedColor = color;
+    batch->issuedColorKnown = true;
+}
+
+/* brings the context to the state the calls so far would have left it in */
+static void Sync(nkDrawBatch_t *batch)
+{
+    nkDrawBatch_Flush(batch);
+
+    if (batch->enabled && batch->colorIsFill)
+    {
+        IssueColor(batch, batch->color);
+    }
+}
+
+static void AddFill(nkDrawBatch_t *batch, nkRect_t rect)
+{
+    nkColor_t color = batch->color;
+
+    if (!(rect.width > 0.0f && rect.height > 0.0f))
+    {
+        return;
+    }
+
+    size_t scanEnd = (batch->fillCount > NK_DRAW_BATCH_SCAN) ? batch->fillCount - NK_DRAW_BATCH_SCAN : 0;
+
+    for (size_t i = batch->fillCount; i > scanEnd; i--)
+    {
+        nkDrawBatchFill_t *fill = &batch->fills[i - 1];
+
+        if (!ColorEquals(fill->color, color))
+        {
+            /* can't move back past a fill it would paint over */
+            if (Overlaps(fill->rect, rect))
+            {
+                break;
+            }
+
+            continue;
+        }
+
+        /* painting an opaque colour over itself changes nothing */
+        if (color.a >= 1.0f && Contains(fill->rect, rect))
+        {
+            return;
+        }
+
+        if (JoinAdjacent(fill->rect, rect, &fill->rect))
+        {
+            return;
+        }
+
+        if (batch->fillCount == NK_DRAW_BATCH_MAX_FILLS)
+        {
+            break;
+        }
+
+        /* join its colour's group */
+        memmove(&batch->fills[i + 1], &batch->fills[i], (batch->fillCount - i) * sizeof(nkDrawBatchFill_t));
+        batch->fills[i] = (nkDrawBatchFill_t){color, rect};
+        batch->fillCount++;
+        return;
+    }
+
+    if (batch->fillCount == NK_DRAW_BATCH_MAX_FILLS)
+    {
+        nkDrawBatch_Flush(batch);
+    }
+
+    batch->fills[batch->fillCount++] = (nkDrawBatchFill_t){color, rect};
+}
@@ -0,0 +1,117 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkdrawbatch.h
+** Module       :  nanoview
+** Author       :  SH
+** Created      :  2025-09-20 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Draw batching: a layer in front of nkDraw that
+**                 drops redundant state changes and groups solid
+**                 rect fills by colour
+**
+***************************************************************/
+
+#ifndef NKDRAWBATCH_H
+#define NKDRAWBATCH_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <nanodraw.h>
+
+#include "nkdisplaylist.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_DRAW_BATCH_MAX_FILLS 256 /* pending fills before a forced flush */
+#define NK_DRAW_BATCH_SCAN 32 /* pending fills a new one looks back over for its colour */
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    uint64_t submitted; /* calls made to the batch */
+    uint64_t issued; /* calls it made to nkDraw */
+} nkDrawBatchStats_t;
+
+/* a solid rect fill not yet issued */
+typedef struct
+{
+    nkColor_t color;
+    nkRect_t rect;
+} nkDrawBatchFill_t;
+
+/* Solid rect fills are held back until the clip scope ends or anything
+   else is drawn. A new fill moves back to the last pending fill of its
+   colour if no fill in between overlaps it, joining it when the two form
+   one rect. State is only set when it differs from what was last issued. */
+typedef struct
+{
+    nkDrawContext_t *context;
+    bool enabled; /* false: every call goes straight to nkDraw */
+
+    nkPoint_t offset; /* added to drawing coordinates, see nkDrawBatch_SetOffset */
+
+    nkDrawBatchFill_t fills[NK_DRAW_BATCH_MAX_FILLS]; /* grouped by colour */
+    size_t fillCount;
+
+    nkColor_t color; /* fill colour set through the batch */
+    bool colorIsFill; /* false after a gradient, so rects can't be held back */
+
+    nkColor_t issuedColor;
+    bool issuedColorKnown;
+    float issuedStrokeWidth;
+    bool issuedStrokeWidthKnown;
+
+    nkDrawBatchStats_t stats;
+} nkDrawBatch_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+void nkDrawBatch_Create(nkDrawBatch_t *batch);
+
+/* starts drawing to context with no state known */
+void nkDrawBatch_Begin(nkDrawBatch_t *batch, nkDrawContext_t *context);
+
+/* issues pending fills; call before drawing to the context directly */
+void nkDrawBatch_Flush(nkDrawBatch_t *batch);
+
+/* forgets the context's state, after drawing to it directly */
+void nkDrawBatch_Invalidate(nkDrawBatch_t *batch);
+
+/* CLIP SCOPES, each flushing first */
+void nkDrawBatch_Save(nkDrawBatch_t *batch);
+void nkDrawBatch_Restore(nkDrawBatch_t *batch);
+void nkDrawBatch_SetClipRect(nkDrawBatch_t *batch, nkRect_t rect);
+
+/* translates the coordinates of the drawing calls that follow, but not
+   clip rects, which are always in context coordinates */
+void nkDrawBatch_SetOffset(nkDrawBatch_t *batch, nkPoint_t offset);
+
+/* DRAWING, each the same as its nkDraw counterpart */
+void nkDrawBatch_SetColor(nkDrawBatch_t *batch, nkColor_t color);
+void nkDrawBatch_SetColorGradient(nkDrawBatch_t *batch, nkColor_t start, nkColor_t end, float angle, float x, float y, float width, float height);
+void nkDrawBatch_SetStrokeColorGradient(nkDrawBatch_t *batch, nkColor_t start, nkColor_t end, float angle, float x, float y, float width, float height);
+void nkDrawBatch_SetStrokeWidth(nkDrawBatch_t *batch, float width);
+void nkDrawBatch_Rect(nkDrawBatch_t *batch, float x, float y, float width, float height);
+void nkDrawBatch_RoundedRect(nkDrawBatch_t *batch, float x, float y, float width, float height, float radius);
+void nkDrawBatch_RoundedRectPath(nkDrawBatch_t *batch, float x, float y, float width, float height, float radius);
+void nkDrawBatch_Text(nkDrawBatch_t *batch, nkFont_t *font, const char *text, float x, float y);
+
+/* submits a display list's calls in order */
+void nkDrawBatch_SubmitList(nkDrawBatch_t *batch, const nkDisplayList_t *list);
+
+#endif /* NKDRAWBATCH_H */
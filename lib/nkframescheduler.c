@@ -0,0 +1,220 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkframescheduler.c
+** Module       :  nanoview
+** Author       :  SH
+** Created      :  2025-09-22 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Frame scheduling: runs layout and render only
+**                 when something changed, and tells the host how
+**                 long it may sleep
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkframescheduler.h"
+
+#include <stdlib.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define INITIAL_TIMER_CAPACITY 8
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void FireTimers(nkFrameScheduler_t *scheduler, double now);
+static double NextDeadline(const nkFrameScheduler_t *scheduler, double now);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkFrameScheduler_Create(nkFrameScheduler_t *scheduler, nkView_t *root, nkSize_t size)
+{
+    scheduler->root = root;
+    scheduler->size = size;
+    scheduler->resized = true; /* never laid out */
+
+    scheduler->partialRepaint = false;
+    nkDamageRegion_Create(&scheduler->damage);
+
+    scheduler->timers = NULL;
+    scheduler->timerCount = 0;
+    scheduler->timerCapacity = 0;
+}
+
+void nkFrameScheduler_Destroy(nkFrameScheduler_t *scheduler)
+{
+    nkDamageRegion_Destroy(&scheduler->damage);
+    free(scheduler->timers);
+
+    scheduler->timers = NULL;
+    scheduler->timerCount = 0;
+    scheduler->timerCapacity = 0;
+}
+
+void nkFrameScheduler_SetSize(nkFrameScheduler_t *scheduler, nkSize_t size)
+{
+    if (size.width != scheduler->size.width || size.height != scheduler->size.height)
+    {
+        scheduler->size = size;
+        scheduler->resized = true;
+    }
+}
+
+bool nkFrameScheduler_AddTimer(nkFrameScheduler_t *scheduler, double time, nkFrameTimerCallback_t callback, nkView_t *view)
+{
+    if (callback == NULL)
+    {
+        return false;
+    }
+
+    if (scheduler->timerCount == scheduler->timerCapacity)
+    {
+        size_t capacity = (scheduler->timerCapacity > 0) ? scheduler->timerCapacity * 2 : INITIAL_TIMER_CAPACITY;
+        nkFrameTimer_t *timers = realloc(scheduler->timers, capacity * sizeof(nkFrameTimer_t));
+
+        if (timers == NULL)
+        {
+            return false;
+        }
+
+        scheduler->timers = timers;
+        scheduler->timerCapacity = capacity;
+    }
+
+    scheduler->timers[scheduler->timerCount++] = (nkFrameTimer_t){time, callback, view};
+
+    return true;
+}
+
+void nkFrameScheduler_RemoveTimers(nkFrameScheduler_t *scheduler, nkView_t *view)
+{
+    for (size_t i = 0; i < scheduler->timerCount;)
+    {
+        if (scheduler->timers[i].view == view)
+        {
+            scheduler->timers[i] = scheduler->timers[--scheduler->timerCount];
+            continue;
+        }
+
+        i++;
+    }
+}
+
+bool nkFrameScheduler_NeedsFrame(const nkFrameScheduler_t *scheduler, double now)
+{
+    return NextDeadline(scheduler, now) <= now;
+}
+
+double nkFrameScheduler_RunFrame(nkFrameScheduler_t *scheduler, nkDrawContext_t *context, double now)
+{
+    nkView_t *root = scheduler->root;
+
+    nkDamageRegion_Clear(&scheduler->damage);
+
+    if (root == NULL)
+    {
+        return NK_FRAME_IDLE;
+    }
+
+    FireTimers(scheduler, now);
+
+    if (scheduler->resized || nkView_NeedsLayout(root))
+    {
+        nkView_LayoutTree(root, scheduler->size, context);
+        scheduler->resized = false;
+    }
+
+    if (nkView_NeedsRender(root))
+    {
+        nkView_CollectDamage(root, &scheduler->damage);
+
+        if (scheduler->partialRepaint)
+        {
+            nkView_RenderDamage(root, context, &scheduler->damage);
+        }
+        else if (scheduler->damage.count > 0)
+        {
+            nkDamageRegion_Clear(&scheduler->damage);
+            nkDamageRegion_Add(&scheduler->damage, root->frame);
+            nkView_RenderTree(root, context);
+        }
+    }
+
+    return NextDeadline(scheduler, now);
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+/* earliest first, and only the timers there were on entry, so a callback
+   adding a timer that is already due can't keep the frame from ending */
+static void FireTimers(nkFrameScheduler_t *scheduler, double now)
+{
+    for (size_t limit = scheduler->timerCount; limit > 0; limit--)
+    {
+        size_t earliest = SIZE_MAX;
+
+        for (size_t i = 0; i < scheduler->timerCount; i++)
+        {
+            if (scheduler->timers[i].time <= now && (earliest == SIZE_MAX || scheduler->timers[i].time < scheduler->timers[earliest].time))
+            {
+                earliest = i;
+            }
+        }
+
+        if (earliest == SIZE_MAX)
+        {
+            return;
+        }
+
+        nkFrameTimer_t timer = scheduler->timers[earliest];
+        scheduler->timers[earliest] = scheduler->timers[--scheduler->timerCount];
+
+        timer.callback(timer.view, now);
+    }
+}
+
+static double NextDeadline(const nkFrameScheduler_t *scheduler, double now)
+{
+    if (scheduler->root == NULL)
+    {
+        return NK_FRAME_IDLE;
+    }
+
+    if (scheduler->resized || nkView_NeedsLayout(scheduler->root) || nkView_NeedsRender(scheduler->root))
+    {
+        return now;
+    }
+
+    double deadline = NK_FRAME_IDLE;
+
+    for (size_t i = 0; i < scheduler->timerCount; i++)
+    {
+        if (scheduler->timers[i].time < deadline)
+        {
+            deadline = scheduler->timers[i].time;
+        }
+    }
+
+    return deadline;
+}
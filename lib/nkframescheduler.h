@@ -0,0 +1,93 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkframescheduler.h
+** Module       :  nanoview
+** Author       :  SH
+** Created      :  2025-09-22 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Frame scheduling: runs layout and render only
+**                 when something changed, and tells the host how
+**                 long it may sleep
+**
+***************************************************************/
+
+#ifndef NKFRAMESCHEDULER_H
+#define NKFRAMESCHEDULER_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <math.h>
+
+#include <nanoview.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_FRAME_IDLE INFINITY /* deadline when nothing is pending: sleep until input */
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* called once its time has come, before the frame's layout */
+typedef void (*nkFrameTimerCallback_t)(nkView_t *view, double now);
+
+typedef struct
+{
+    double time;
+    nkFrameTimerCallback_t callback;
+    nkView_t *view;
+} nkFrameTimer_t;
+
+/* Invalidations made between frames (nkView_Invalidate*, tree edits,
+   scroll offsets...) only flag the tree, so any number of them cost one
+   layout and one render at the next frame. Times are in seconds on any
+   clock the host likes, as long as it is the same one throughout. */
+typedef struct
+{
+    nkView_t *root;
+    nkSize_t size; /* window size the tree is laid out to */
+    bool resized; /* size changed since the last frame */
+
+    bool partialRepaint; /* render only the damage, see nkView_CollectDamage */
+    nkDamageRegion_t damage; /* what the last frame repainted, empty if nothing */
+
+    nkFrameTimer_t *timers; /* unordered, one-shot */
+    size_t timerCount;
+    size_t timerCapacity;
+} nkFrameScheduler_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+void nkFrameScheduler_Create(nkFrameScheduler_t *scheduler, nkView_t *root, nkSize_t size);
+void nkFrameScheduler_Destroy(nkFrameScheduler_t *scheduler);
+
+void nkFrameScheduler_SetSize(nkFrameScheduler_t *scheduler, nkSize_t size);
+
+/* wakes the scheduler at time to call callback, e.g. for the next step of
+   an animation. Returns false if the timer couldn't be stored. */
+bool nkFrameScheduler_AddTimer(nkFrameScheduler_t *scheduler, double time, nkFrameTimerCallback_t callback, nkView_t *view);
+
+/* drops the view's pending timers, e.g. before destroying it */
+void nkFrameScheduler_RemoveTimers(nkFrameScheduler_t *scheduler, nkView_t *view);
+
+/* true if a frame run now would do anything */
+bool nkFrameScheduler_NeedsFrame(const nkFrameScheduler_t *scheduler, double now);
+
+/* Fires the due timers, then lays out and renders if anything changed. The
+   host presents scheduler->damage (nothing if it is empty) and may block
+   until the returned deadline or the next input, whichever comes first:
+   now if work is still pending, NK_FRAME_IDLE if there is none at all. */
+double nkFrameScheduler_RunFrame(nkFrameScheduler_t *scheduler, nkDrawContext_t *context, double now);
+
+#endif /* NKFRAMESCHEDULER_H */
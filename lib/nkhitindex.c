@@ -0,0 +1,462 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkhitindex.c
+** Module       :  nanoview
+** Author       :  SH
+** Created      :  2025-09-24 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Hit index: a bounding volume hierarchy over a
+**                 view's children, so a point query looks at the
+**                 few children near it instead of all of them
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkhitindex.h"
+
+#include <stdlib.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define LEAF_SIZE 4 /* children a leaf holds at most */
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    nkView_t *view;
+    uint32_t order;
+    float centerX;
+    float centerY;
+} HitEntry_t;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void BuildNode(nkHitIndex_t *index, HitEntry_t *entries, uint32_t first, uint32_t count);
+static int CompareCenterX(const void *a, const void *b);
+static int CompareCenterY(const void *a, const void *b);
+static int CompareOrder(const void *a, const void *b);
+static bool FindOrder(const nkHitIndex_t *index, const nkView_t *view, uint32_t *order);
+static bool Contains(nkRect_t rect, float x, float y);
+static bool Touches(nkRect_t rect, float left, float top, float right, float bottom);
+static void AddFrame(nkHitIndexNode_t *node, nkRect_t frame);
+static void AddNode(nkHitIndexNode_t *node, const nkHitIndexNode_t *other);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkHitIndex_Create(nkHitIndex_t *index)
+{
+    index->views = NULL;
+    index->orders = NULL;
+    index->count = 0;
+
+    index->nodes = NULL;
+    index->nodeCount = 0;
+    index->capacity = 0;
+
+    index->valid = false;
+    index->structureVersion = 0;
+    index->stale = false;
+}
+
+void nkHitIndex_Destroy(nkHitIndex_t *index)
+{
+    free(index->views);
+    free(index->orders);
+    free(index->nodes);
+
+    nkHitIndex_Create(index);
+}
+
+bool nkHitIndex_Build(nkHitIndex_t *index, nkView_t *parent)
+{
+    size_t count = parent->childCount;
+
+    index->valid = false;
+
+    if (count > index->capacity)
+    {
+        /* leaves hold at least two children, so there are fewer nodes than children */
+        nkView_t **views = realloc(index->views, count * sizeof(nkView_t *));
+
+        if (views != NULL)
+        {
+            index->views = views;
+        }
+
+        uint32_t *orders = realloc(index->orders, count * sizeof(uint32_t));
+
+        if (orders != NULL)
+        {
+            index->orders = orders;
+        }
+
+        nkHitIndexNode_t *nodes = realloc(index->nodes, count * sizeof(nkHitIndexNode_t));
+
+        if (nodes != NULL)
+        {
+            index->nodes = nodes;
+        }
+
+        if (views == NULL || orders == NULL || nodes == NULL)
+        {
+            return false;
+        }
+
+        index->capacity = count;
+    }
+
+    HitEntry_t *entries = malloc(count * sizeof(HitEntry_t));
+
+    if (entries == NULL && count > 0)
+    {
+        return false;
+    }
+
+    uint32_t order = 0;
+
+    for (nkView_t *child = parent->child; child != NULL; child = child->sibling)
+    {
+        entries[order] = (HitEntry_t){
+            child,
+            order,
+            child->frame.x + child->frame.width * 0.5f,
+            child->frame.y + child->frame.height * 0.5f
+        };
+
+        order++;
+    }
+
+    index->count = count;
+    index->nodeCount = 0;
+
+    if (count > 0)
+    {
+        BuildNode(index, entries, 0, (uint32_t)count);
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        index->views[i] = entries[i].view;
+        index->orders[i] = entries[i].order;
+    }
+
+    free(entries);
+
+    nkHitIndex_Refit(index);
+
+    index->valid = true;
+    index->structureVersion = parent->structureVersion;
+
+    return true;
+}
+
+void nkHitIndex_Refit(nkHitIndex_t *index)
+{
+    /* descendants come after their node, so walking backwards finishes them first */
+    for (size_t i = index->nodeCount; i-- > 0;)
+    {
+        nkHitIndexNode_t *node = &index->nodes[i];
+
+        if (node->count > 0)
+        {
+            nkRect_t frame = index->views[node->first]->frame;
+
+            node->left = frame.x;
+            node->top = frame.y;
+            node->right = frame.x + frame.width;
+            node->bottom = frame.y + frame.height;
+            node->minOrder = index->orders[node->first];
+            node->maxOrder = node->minOrder;
+
+            for (uint32_t j = node->first + 1; j < node->first + node->count; j++)
+            {
+                AddFrame(node, index->views[j]->frame);
+
+                if (index->orders[j] < node->minOrder)
+                {
+                    node->minOrder = index->orders[j];
+                }
+
+                if (index->orders[j] > node->maxOrder)
+                {
+                    node->maxOrder = index->orders[j];
+                }
+            }
+        }
+        else
+        {
+            const nkHitIndexNode_t *first = &index->nodes[i + 1];
+
+            *node = (nkHitIndexNode_t){
+                first->left, first->top, first->right, first->bottom,
+                first->minOrder, first->maxOrder,
+                node->end, node->first, 0
+            };
+
+            AddNode(node, &index->nodes[first->end]);
+        }
+    }
+
+    index->stale = false;
+}
+
+nkView_t *nkHitIndex_Topmost(const nkHitIndex_t *index, float x, float y, uint32_t below, uint32_t *order)
+{
+    nkView_t *best = NULL;
+    uint32_t bestOrder = 0;
+
+    for (size_t i = 0; i < index->nodeCount;)
+    {
+        const nkHitIndexNode_t *node = &index->nodes[i];
+
+        /* nothing below can beat what was found, or be under below */
+        if (node->minOrder >= below
+            || (best != NULL && node->maxOrder <= bestOrder)
+            || x < node->left || x > node->right || y < node->top || y > node->bottom)
+        {
+            i = node->end;
+            continue;
+        }
+
+        for (uint32_t j = node->first; j < node->first + node->count; j++)
+        {
+            uint32_t childOrder = index->orders[j];
+
+            if (childOrder < below && (best == NULL || childOrder > bestOrder) && Contains(index->views[j]->frame, x, y))
+            {
+                best = index->views[j];
+                bestOrder = childOrder;
+            }
+        }
+
+        i++;
+    }
+
+    *order = bestOrder;
+
+    return best;
+}
+
+bool nkHitIndex_Overlaps(const nkHitIndex_t *index, float left, float top, float right, float bottom, const nkView_t *above)
+{
+    uint32_t minOrder = 0;
+
+    if (above != NULL)
+    {
+        if (!FindOrder(index, above, &minOrder))
+        {
+            return true;
+        }
+
+        minOrder++;
+    }
+
+    for (size_t i = 0; i < index->nodeCount;)
+    {
+        const nkHitIndexNode_t *node = &index->nodes[i];
+
+        if (node->maxOrder < minOrder
+            || node->left > right || node->right < left || node->top > bottom || node->bottom < top)
+        {
+            i = node->end;
+            continue;
+        }
+
+        for (uint32_t j = node->first; j < node->first + node->count; j++)
+        {
+            if (index->orders[j] >= minOrder && Touches(index->views[j]->frame, left, top, right, bottom))
+            {
+                return true;
+            }
+        }
+
+        i++;
+    }
+
+    return false;
+}
+
+size_t nkHitIndex_Collect(const nkHitIndex_t *index, float left, float top, float right, float bottom, nkHitIndexMatch_t *matches, size_t capacity)
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < index->nodeCount;)
+    {
+        const nkHitIndexNode_t *node = &index->nodes[i];
+
+        if (node->left > right || node->right < left || node->top > bottom || node->bottom < top)
+        {
+            i = node->end;
+            continue;
+        }
+
+        for (uint32_t j = node->first; j < node->first + node->count; j++)
+        {
+            if (Touches(index->views[j]->frame, left, top, right, bottom))
+            {
+                if (count == capacity)
+                {
+                    return capacity + 1;
+                }
+
+                matches[count++] = (nkHitIndexMatch_t){index->orders[j], index->views[j]};
+            }
+        }
+
+        i++;
+    }
+
+    /* leaves are grouped by place, not by order */
+    if (count > 1)
+    {
+        qsort(matches, count, sizeof(nkHitIndexMatch_t), CompareOrder);
+    }
+
+    return count;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+/* the view's sibling position, found through the nodes holding its frame's corner */
+static bool FindOrder(const nkHitIndex_t *index, const nkView_t *view, uint32_t *order)
+{
+    float x = view->frame.x;
+    float y = view->frame.y;
+
+    for (size_t i = 0; i < index->nodeCount;)
+    {
+        const nkHitIndexNode_t *node = &index->nodes[i];
+
+        if (x < node->left || x > node->right || y < node->top || y > node->bottom)
+        {
+            i = node->end;
+            continue;
+        }
+
+        for (uint32_t j = node->first; j < node->first + node->count; j++)
+        {
+            if (index->views[j] == view)
+            {
+                *order = index->orders[j];
+                return true;
+            }
+        }
+
+        i++;
+    }
+
+    return false;
+}
+
+/* splits at the median along the axis the children's centres spread over most */
+static void BuildNode(nkHitIndex_t *index, HitEntry_t *entries, uint32_t first, uint32_t count)
+{
+    uint32_t node = (uint32_t)index->nodeCount++;
+
+    if (count <= LEAF_SIZE)
+    {
+        index->nodes[node].first = first;
+        index->nodes[node].count = count;
+        index->nodes[node].end = node + 1;
+        return;
+    }
+
+    float minX = entries[first].centerX, maxX = minX;
+    float minY = entries[first].centerY, maxY = minY;
+
+    for (uint32_t i = first + 1; i < first + count; i++)
+    {
+        if (entries[i].centerX < minX) minX = entries[i].centerX;
+        if (entries[i].centerX > maxX) maxX = entries[i].centerX;
+        if (entries[i].centerY < minY) minY = entries[i].centerY;
+        if (entries[i].centerY > maxY) maxY = entries[i].centerY;
+    }
+
+    qsort(&entries[first], count, sizeof(HitEntry_t), (maxX - minX >= maxY - minY) ? CompareCenterX : CompareCenterY);
+
+    uint32_t half = count / 2;
+
+    BuildNode(index, entries, first, half);
+    BuildNode(index, entries, first + half, count - half);
+
+    index->nodes[node].first = first;
+    index->nodes[node].count = 0;
+    index->nodes[node].end = (uint32_t)index->nodeCount;
+}
+
+static int CompareCenterX(const void *a, const void *b)
+{
+    float centerA = ((const HitEntry_t *)a)->centerX;
+    float centerB = ((const HitEntry_t *)b)->centerX;
+
+    return (centerA > centerB) - (centerA < centerB);
+}
+
+static int CompareCenterY(const void *a, const void *b)
+{
+    float centerA = ((const HitEntry_t *)a)->centerY;
+    float centerB = ((const HitEntry_t *)b)->centerY;
+
+    return (centerA > centerB) - (centerA < centerB);
+}
+
+static int CompareOrder(const void *a, const void *b)
+{
+    uint32_t orderA = ((const nkHitIndexMatch_t *)a)->order;
+    uint32_t orderB = ((const nkHitIndexMatch_t *)b)->order;
+
+    return (orderA > orderB) - (orderA < orderB);
+}
+
+/* edges included, as nkView_HitTest */
+static bool Contains(nkRect_t rect, float x, float y)
+{
+    return x >= rect.x && x <= rect.x + rect.width && y >= rect.y && y <= rect.y + rect.height;
+}
+
+/* edges included on both sides */
+static bool Touches(nkRect_t rect, float left, float top, float right, float bottom)
+{
+    return rect.x <= right && rect.x + rect.width >= left && rect.y <= bottom && rect.y + rect.height >= top;
+}
+
+/* Edges are kept as the hit test computes them, so a point on a frame's edge
+   is inside its node too. Unlike the damage code, empty frames still count:
+   their edges can be hit. */
+static void AddFrame(nkHitIndexNode_t *node, nkRect_t frame)
+{
+    if (frame.x < node->left) node->left = frame.x;
+    if (frame.y < node->top) node->top = frame.y;
+    if (frame.x + frame.width > node->right) node->right = frame.x + frame.width;
+    if (frame.y + frame.height > node->bottom) node->bottom = frame.y + frame.height;
+}
+
+static void AddNode(nkHitIndexNode_t *node, const nkHitIndexNode_t *other)
+{
+    if (other->left < node->left) node->left = other->left;
+    if (other->top < node->top) node->top = other->top;
+    if (other->right > node->right) node->right = other->right;
+    if (other->bottom > node->bottom) node->bottom = other->bottom;
+    if (other->minOrder < node->minOrder) node->minOrder = other->minOrder;
+    if (other->maxOrder > node->maxOrder) node->maxOrder = other->maxOrder;
+}
@@ -0,0 +1,101 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkhitindex.h
+** Module       :  nanoview
+** Author       :  SH
+** Created      :  2025-09-24 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Hit index: a bounding volume hierarchy over a
+**                 view's children, so a point query looks at the
+**                 few children near it instead of all of them
+**
+***************************************************************/
+
+#ifndef NKHITINDEX_H
+#define NKHITINDEX_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <nanoview.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_HIT_INDEX_MIN_CHILDREN 16 /* fewer children are quicker to walk */
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* Nodes are stored in pre-order, like nkFrozenSubtree_t, so a node's
+   descendants follow it and end is where the walk skips to. */
+typedef struct
+{
+    float left, top, right, bottom; /* edges around the frames of every child below */
+    uint32_t minOrder; /* lowest and highest sibling position below */
+    uint32_t maxOrder;
+    uint32_t end; /* one past the node's last descendant */
+    uint32_t first; /* a leaf's children, as a range of views */
+    uint32_t count; /* 0 for an inner node, whose two children are the next node and the one at its end */
+} nkHitIndexNode_t;
+
+typedef struct
+{
+    uint32_t order; /* position among its siblings */
+    nkView_t *view;
+} nkHitIndexMatch_t;
+
+typedef struct nkHitIndex_t
+{
+    nkView_t **views; /* the parent's children, grouped by leaf */
+    uint32_t *orders; /* each one's position among its siblings, first child 0 */
+    size_t count;
+
+    nkHitIndexNode_t *nodes;
+    size_t nodeCount;
+    size_t capacity;
+
+    bool valid; /* built for structureVersion */
+    uint32_t structureVersion; /* the parent's when built */
+    bool stale; /* a child's frame changed since, so bounds need refitting */
+} nkHitIndex_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+void nkHitIndex_Create(nkHitIndex_t *index);
+void nkHitIndex_Destroy(nkHitIndex_t *index);
+
+/* Rebuilds over parent's current children and frames. Returns false,
+   leaving the index invalid, if storage couldn't be allocated. */
+bool nkHitIndex_Build(nkHitIndex_t *index, nkView_t *parent);
+
+/* recomputes bounds from the children's frames, keeping the tree shape */
+void nkHitIndex_Refit(nkHitIndex_t *index);
+
+/* The last child in sibling order before below whose frame contains x, y
+   (edges included, as nkView_HitTest), or NULL. Its position goes to order,
+   so passing that back as below finds the next one underneath. */
+nkView_t *nkHitIndex_Topmost(const nkHitIndex_t *index, float x, float y, uint32_t below, uint32_t *order);
+
+/* true if a child's frame touches the given edges, counting only the
+   children drawn over above unless it is NULL. Also true if above can't be
+   found, so callers relying on a false answer stay safe. */
+bool nkHitIndex_Overlaps(const nkHitIndex_t *index, float left, float top, float right, float bottom, const nkView_t *above);
+
+/* Writes the children whose frames touch the given edges to matches, in
+   sibling order, and returns how many there are. Stops at capacity + 1 if
+   there are more, leaving matches unsorted. */
+size_t nkHitIndex_Collect(const nkHitIndex_t *index, float left, float top, float right, float bottom, nkHitIndexMatch_t *matches, size_t capacity);
+
+#endif /* NKHITINDEX_H */
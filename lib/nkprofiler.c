@@ -0,0 +1,260 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkprofiler.c
+** Module       :  nanoview
+** Author       :  SH
+** Created      :  2025-09-16 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Per-view timing of measure, arrange and draw
+**                 callbacks (NANOVIEW_PROFILE)
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkprofiler.h"
+
+#include <nanoview.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#ifdef NANOVIEW_PARALLEL
+#include <stdatomic.h>
+#endif
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define UNNAMED_TYPE "(unnamed)"
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static nkProfileType_t *types = NULL;
+static size_t typeCount = 0;
+static size_t typeCapacity = 0;
+
+static uint64_t budget = 0;
+static nkProfileSlowCallback_t slowCallback = NULL;
+static void *slowUserData = NULL;
+
+/* inclusive time of the callbacks finished inside the one running */
+static _Thread_local uint64_t nestedTime = 0;
+
+#ifdef NANOVIEW_PARALLEL
+static atomic_flag typeLock = ATOMIC_FLAG_INIT; /* measure callbacks may end on several threads */
+#endif
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static size_t FindTypeSlot(const char *name);
+static void AddSample(nkProfileStats_t *stats, uint64_t self, uint64_t inclusive);
+static void LockTypes(void);
+static void UnlockTypes(void);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+uint64_t nkProfiler_Now(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+#endif
+}
+
+void nkProfiler_SetBudget(uint64_t nanoseconds, nkProfileSlowCallback_t callback, void *userData)
+{
+    budget = (callback != NULL) ? nanoseconds : 0;
+    slowCallback = callback;
+    slowUserData = userData;
+}
+
+const nkProfileStats_t *nkProfiler_ViewStats(const nkView_t *view, nkProfilePhase_t phase)
+{
+    if (view == NULL || phase >= NK_PROFILE_PHASE_COUNT)
+    {
+        return NULL;
+    }
+
+    return &view->profile.phases[phase];
+}
+
+size_t nkProfiler_TypeCount(void)
+{
+    return typeCount;
+}
+
+const nkProfileType_t *nkProfiler_Type(size_t index)
+{
+    return (index < typeCount) ? &types[index] : NULL;
+}
+
+const nkProfileType_t *nkProfiler_FindType(const char *name)
+{
+    name = (name != NULL) ? name : UNNAMED_TYPE;
+
+    for (size_t i = 0; i < typeCount; i++)
+    {
+        if (strcmp(types[i].name, name) == 0)
+        {
+            return &types[i];
+        }
+    }
+
+    return NULL;
+}
+
+void nkProfiler_Reset(nkView_t *root)
+{
+    /* types stay registered, views cache their slot */
+    for (size_t i = 0; i < typeCount; i++)
+    {
+        memset(types[i].phases, 0, sizeof(types[i].phases));
+    }
+
+    nkViewIterator_t iterator;
+
+    for (nkView_t *view = nkView_PreOrderBegin(&iterator, root); view; view = nkView_PreOrderNext(&iterator))
+    {
+        memset(view->profile.phases, 0, sizeof(view->profile.phases));
+    }
+}
+
+nkProfileScope_t nkProfiler_Begin(void)
+{
+    nkProfileScope_t scope = {nkProfiler_Now(), nestedTime};
+    nestedTime = 0;
+
+    return scope;
+}
+
+void nkProfiler_End(nkView_t *view, nkProfilePhase_t phase, nkProfileScope_t scope)
+{
+    uint64_t inclusive = nkProfiler_Now() - scope.start;
+    uint64_t self = (inclusive > nestedTime) ? inclusive - nestedTime : 0;
+
+    nestedTime = scope.nested + inclusive;
+
+    AddSample(&view->profile.phases[phase], self, inclusive);
+
+    LockTypes();
+
+    if (view->profile.typeName != view->name || view->profile.type >= typeCount)
+    {
+        view->profile.type = FindTypeSlot(view->name);
+        view->profile.typeName = view->name;
+    }
+
+    if (view->profile.type < typeCount)
+    {
+        AddSample(&types[view->profile.type].phases[phase], self, inclusive);
+    }
+
+    UnlockTypes();
+
+    if (budget > 0 && self > budget)
+    {
+        slowCallback(view, phase, self, slowUserData);
+    }
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+/* registers name if needed, SIZE_MAX if out of memory */
+static size_t FindTypeSlot(const char *name)
+{
+    name = (name != NULL) ? name : UNNAMED_TYPE;
+
+    for (size_t i = 0; i < typeCount; i++)
+    {
+        if (strcmp(types[i].name, name) == 0)
+        {
+            return i;
+        }
+    }
+
+    if (typeCount == typeCapacity)
+    {
+        size_t capacity = (typeCapacity > 0) ? typeCapacity * 2 : 16;
+        nkProfileType_t *newTypes = realloc(types, capacity * sizeof(nkProfileType_t));
+
+        if (newTypes == NULL)
+        {
+            return SIZE_MAX;
+        }
+
+        types = newTypes;
+        typeCapacity = capacity;
+    }
+
+    /* views may free their name, the type keeps its own copy */
+    size_t length = strlen(name) + 1;
+    char *copy = malloc(length);
+
+    if (copy == NULL)
+    {
+        return SIZE_MAX;
+    }
+
+    memcpy(copy, name, length);
+
+    types[typeCount] = (nkProfileType_t){.name = copy};
+
+    return typeCount++;
+}
+
+static void AddSample(nkProfileStats_t *stats, uint64_t self, uint64_t inclusive)
+{
+    stats->calls++;
+    stats->totalNanoseconds += self;
+    stats->inclusiveNanoseconds += inclusive;
+
+    if (self > stats->maxNanoseconds)
+    {
+        stats->maxNanoseconds = self;
+    }
+}
+
+static void LockTypes(void)
+{
+#ifdef NANOVIEW_PARALLEL
+    while (atomic_flag_test_and_set_explicit(&typeLock, memory_order_acquire))
+    {
+    }
+#endif
+}
+
+static void UnlockTypes(void)
+{
+#ifdef NANOVIEW_PARALLEL
+    atomic_flag_clear_explicit(&typeLock, memory_order_release);
+#endif
+}
@@ -0,0 +1,103 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkprofiler.h
+** Module       :  nanoview
+** Author       :  SH
+** Created      :  2025-09-16 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Per-view timing of measure, arrange and draw
+**                 callbacks (NANOVIEW_PROFILE)
+**
+***************************************************************/
+
+#ifndef NKPROFILER_H
+#define NKPROFILER_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+struct nkView_t; /* forward declaration */
+
+typedef enum
+{
+    NK_PROFILE_MEASURE,
+    NK_PROFILE_ARRANGE,
+    NK_PROFILE_DRAW,
+    NK_PROFILE_PHASE_COUNT
+} nkProfilePhase_t;
+
+/* times are the callback's own, without the callbacks it runs in turn
+   (a container measuring its children); inclusive times add them back */
+typedef struct
+{
+    uint64_t calls;
+    uint64_t totalNanoseconds;
+    uint64_t maxNanoseconds; /* slowest single call */
+    uint64_t inclusiveNanoseconds;
+} nkProfileStats_t;
+
+/* totals over every view sharing a name */
+typedef struct
+{
+    const char *name;
+    nkProfileStats_t phases[NK_PROFILE_PHASE_COUNT];
+} nkProfileType_t;
+
+/* view's per-view stats, embedded in nkView_t */
+typedef struct
+{
+    nkProfileStats_t phases[NK_PROFILE_PHASE_COUNT];
+    const char *typeName; /* name the type slot was looked up for */
+    size_t type;
+} nkViewProfile_t;
+
+typedef void (*nkProfileSlowCallback_t)(struct nkView_t *view, nkProfilePhase_t phase, uint64_t nanoseconds, void *userData);
+
+/* an open callback, see nkProfiler_Begin */
+typedef struct
+{
+    uint64_t start;
+    uint64_t nested; /* inclusive time of the enclosing callback's earlier children */
+} nkProfileScope_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* monotonic time in nanoseconds */
+uint64_t nkProfiler_Now(void);
+
+/* callback fires, on the thread that ran it, whenever a single callback's
+   own time exceeds nanoseconds. 0 or a NULL callback disables it. */
+void nkProfiler_SetBudget(uint64_t nanoseconds, nkProfileSlowCallback_t callback, void *userData);
+
+const nkProfileStats_t *nkProfiler_ViewStats(const struct nkView_t *view, nkProfilePhase_t phase);
+
+/* types are listed in the order they were first seen */
+size_t nkProfiler_TypeCount(void);
+const nkProfileType_t *nkProfiler_Type(size_t index);
+const nkProfileType_t *nkProfiler_FindType(const char *name); /* NULL if never seen */
+
+/* clears the type totals, and the per-view stats of root's subtree if given */
+void nkProfiler_Reset(struct nkView_t *root);
+
+/* used by the layout and render passes around every callback */
+nkProfileScope_t nkProfiler_Begin(void);
+void nkProfiler_End(struct nkView_t *view, nkProfilePhase_t phase, nkProfileScope_t scope);
+
+#endif /* NKPROFILER_H */
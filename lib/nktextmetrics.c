@@ -0,0 +1,105 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nktextmetrics.c
+** Module       :  nanoview
+** Author       :  SH
+** Created      :  2025-09-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Text measurement without a draw context, for
+**                 headless layout
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktextmetrics.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static nkRect_t MeasureFixed(const nkTextMetrics_t *metrics, nkFont_t *font, const char *text);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkFixedTextMetrics_Create(nkFixedTextMetrics_t *fixedMetrics, float advance, float lineHeight)
+{
+    fixedMetrics->metrics.measureText = MeasureFixed;
+    fixedMetrics->metrics.generation = 0;
+
+    for (int i = 0; i < 128; i++)
+    {
+        fixedMetrics->advances[i] = (i >= 32 && i < 127) ? advance : 0.0f;
+    }
+
+    fixedMetrics->fallbackAdvance = advance;
+    fixedMetrics->lineHeight = lineHeight;
+}
+
+void nkFixedTextMetrics_SetAdvance(nkFixedTextMetrics_t *fixedMetrics, const char *characters, float advance)
+{
+    for (const unsigned char *c = (const unsigned char *)characters; *c; c++)
+    {
+        if (*c < 128)
+        {
+            fixedMetrics->advances[*c] = advance;
+        }
+    }
+
+    fixedMetrics->metrics.generation++;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static nkRect_t MeasureFixed(const nkTextMetrics_t *metrics, nkFont_t *font, const char *text)
+{
+    const nkFixedTextMetrics_t *fixedMetrics = (const nkFixedTextMetrics_t *)metrics;
+    float width = 0.0f;
+    float lineWidth = 0.0f;
+    size_t lines = 1;
+
+    (void)font;
+
+    for (const unsigned char *c = (const unsigned char *)text; *c; c++)
+    {
+        if (*c == '\n')
+        {
+            width = (lineWidth > width) ? lineWidth : width;
+            lineWidth = 0.0f;
+            lines++;
+        }
+        else if (*c < 128)
+        {
+            lineWidth += fixedMetrics->advances[*c];
+        }
+        else if ((*c & 0xC0) != 0x80)
+        {
+            /* lead byte of a UTF-8 sequence, continuation bytes add nothing */
+            lineWidth += fixedMetrics->fallbackAdvance;
+        }
+    }
+
+    width = (lineWidth > width) ? lineWidth : width;
+
+    return (nkRect_t){0.0f, 0.0f, width, (float)lines * fixedMetrics->lineHeight};
+}
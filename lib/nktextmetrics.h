@@ -0,0 +1,68 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nktextmetrics.h
+** Module       :  nanoview
+** Author       :  SH
+** Created      :  2025-09-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Text measurement without a draw context, for
+**                 headless layout
+**
+***************************************************************/
+
+#ifndef NKTEXTMETRICS_H
+#define NKTEXTMETRICS_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <nanodraw.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* A provider embeds this as its first member, and measureText casts back
+   to it. Returns the same frame nkDraw_MeasureText would. Cached measures
+   are kept per provider and generation, so a provider whose measurements
+   change in place must bump generation. */
+typedef struct nkTextMetrics_t
+{
+    nkRect_t (*measureText)(const struct nkTextMetrics_t *metrics, nkFont_t *font, const char *text);
+    uint32_t generation;
+} nkTextMetrics_t;
+
+/* built-in provider: a fixed advance per ASCII byte, the same for every
+   font. Lines break at '\n'. */
+typedef struct
+{
+    nkTextMetrics_t metrics;    /* metrics */
+
+    float advances[128];        /* per ASCII byte */
+    float fallbackAdvance;      /* any other code point */
+    float lineHeight;
+} nkFixedTextMetrics_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* every printable character and code point advances by advance, control
+   characters by nothing */
+void nkFixedTextMetrics_Create(nkFixedTextMetrics_t *fixedMetrics, float advance, float lineHeight);
+
+/* sets the advance of each ASCII byte in characters, bumping generation */
+void nkFixedTextMetrics_SetAdvance(nkFixedTextMetrics_t *fixedMetrics, const char *characters, float advance);
+
+#endif /* NKTEXTMETRICS_H */
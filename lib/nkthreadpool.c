@@ -0,0 +1,363 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkthreadpool.c
+** Module       :  nanoview
+** Author       :  SH
+** Created      :  2025-09-13 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Small work-stealing thread pool used by the
+**                 parallel measure pass (NANOVIEW_PARALLEL)
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkthreadpool.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define INITIAL_DEQUE_CAPACITY 64
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    nkTaskFunction_t function;
+    void *argument;
+    nkTaskGroup_t *group;
+} Task_t;
+
+/* each thread owns one deque. The owner pushes and pops at the tail,
+   thieves take from the head, so stolen work is the oldest and largest */
+typedef struct
+{
+    pthread_mutex_t lock;
+    Task_t *tasks;
+    size_t capacity;
+    size_t head;
+    size_t tail;
+} Deque_t;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static Deque_t deques[NK_THREAD_POOL_MAX_THREADS];
+static pthread_t threads[NK_THREAD_POOL_MAX_THREADS];
+static size_t threadCount = 0;
+
+static atomic_bool running = false;
+static atomic_size_t queuedTasks = 0;
+
+static pthread_mutex_t sleepLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sleepCondition = PTHREAD_COND_INITIALIZER;
+
+static pthread_mutex_t serialLock;
+
+static _Thread_local size_t threadIndex = 0; /* callers outside the pool share deque 0 */
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void DestroyDeques(size_t first, size_t end);
+static bool PushTask(Deque_t *deque, Task_t task);
+static bool PopTask(Deque_t *deque, Task_t *task);
+static bool StealTask(Deque_t *deque, Task_t *task);
+static bool RunOneTask(void);
+static void *WorkerMain(void *argument);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool nkThreadPool_Start(size_t count)
+{
+    if (count > NK_THREAD_POOL_MAX_THREADS)
+    {
+        count = NK_THREAD_POOL_MAX_THREADS;
+    }
+
+    if (count == threadCount)
+    {
+        return true;
+    }
+
+    nkThreadPool_Stop();
+
+    if (count < 2)
+    {
+        return false;
+    }
+
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&serialLock, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        pthread_mutex_init(&deques[i].lock, NULL);
+        deques[i].tasks = malloc(INITIAL_DEQUE_CAPACITY * sizeof(Task_t));
+        deques[i].capacity = INITIAL_DEQUE_CAPACITY;
+        deques[i].head = 0;
+        deques[i].tail = 0;
+
+        if (deques[i].tasks == NULL)
+        {
+            DestroyDeques(0, i + 1);
+            pthread_mutex_destroy(&serialLock);
+            return false;
+        }
+    }
+
+    atomic_store(&running, true);
+    threadCount = count;
+
+    for (size_t i = 1; i < count; i++)
+    {
+        if (pthread_create(&threads[i], NULL, WorkerMain, (void *)i) != 0)
+        {
+            /* run with however many workers did start, dropping the deques
+               of the ones that didn't. Workers only look at threadCount
+               deques, and none has been handed work yet. */
+            DestroyDeques(i, count);
+            threadCount = i;
+            break;
+        }
+    }
+
+    if (threadCount < 2)
+    {
+        nkThreadPool_Stop();
+        return false;
+    }
+
+    return true;
+}
+
+void nkThreadPool_Stop(void)
+{
+    if (threadCount == 0)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&sleepLock);
+    atomic_store(&running, false);
+    pthread_cond_broadcast(&sleepCondition);
+    pthread_mutex_unlock(&sleepLock);
+
+    for (size_t i = 1; i < threadCount; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    DestroyDeques(0, threadCount);
+    pthread_mutex_destroy(&serialLock);
+
+    threadCount = 0;
+}
+
+size_t nkThreadPool_ThreadCount(void)
+{
+    return threadCount;
+}
+
+void nkThreadPool_Submit(nkTaskGroup_t *group, nkTaskFunction_t function, void *argument)
+{
+    if (threadCount == 0)
+    {
+        function(argument);
+        return;
+    }
+
+    if (!PushTask(&deques[threadIndex], (Task_t){function, argument, group}))
+    {
+        /* no room to queue it */
+        function(argument);
+        return;
+    }
+
+    pthread_mutex_lock(&sleepLock);
+    pthread_cond_signal(&sleepCondition);
+    pthread_mutex_unlock(&sleepLock);
+}
+
+void nkThreadPool_Wait(nkTaskGroup_t *group)
+{
+    while (atomic_load(&group->pending) > 0)
+    {
+        if (!RunOneTask())
+        {
+            sched_yield();
+        }
+    }
+}
+
+void nkThreadPool_LockSerial(void)
+{
+    pthread_mutex_lock(&serialLock);
+}
+
+void nkThreadPool_UnlockSerial(void)
+{
+    pthread_mutex_unlock(&serialLock);
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void DestroyDeques(size_t first, size_t end)
+{
+    for (size_t i = first; i < end; i++)
+    {
+        pthread_mutex_destroy(&deques[i].lock);
+        free(deques[i].tasks);
+        memset(&deques[i], 0, sizeof(Deque_t));
+    }
+}
+
+/* counts the task in its group and the queue, unless the ring was full and
+   could not grow, when it returns false and counts nothing */
+static bool PushTask(Deque_t *deque, Task_t task)
+{
+    pthread_mutex_lock(&deque->lock);
+
+    size_t count = deque->tail - deque->head;
+
+    if (count == deque->capacity)
+    {
+        /* unwrap into a larger ring */
+        Task_t *tasks = malloc(2 * deque->capacity * sizeof(Task_t));
+
+        if (tasks == NULL)
+        {
+            pthread_mutex_unlock(&deque->lock);
+            return false;
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            tasks[i] = deque->tasks[(deque->head + i) % deque->capacity];
+        }
+
+        free(deque->tasks);
+
+        deque->tasks = tasks;
+        deque->capacity *= 2;
+        deque->head = 0;
+        deque->tail = count;
+    }
+
+    /* counted before it can be taken, so a thief's decrement never
+       comes first and wraps the count */
+    atomic_fetch_add(&task.group->pending, 1);
+    atomic_fetch_add(&queuedTasks, 1);
+
+    deque->tasks[deque->tail % deque->capacity] = task;
+    deque->tail++;
+
+    pthread_mutex_unlock(&deque->lock);
+
+    return true;
+}
+
+static bool PopTask(Deque_t *deque, Task_t *task)
+{
+    bool found = false;
+
+    pthread_mutex_lock(&deque->lock);
+
+    if (deque->tail > deque->head)
+    {
+        deque->tail--;
+        *task = deque->tasks[deque->tail % deque->capacity];
+        found = true;
+    }
+
+    pthread_mutex_unlock(&deque->lock);
+
+    return found;
+}
+
+static bool StealTask(Deque_t *deque, Task_t *task)
+{
+    bool found = false;
+
+    pthread_mutex_lock(&deque->lock);
+
+    if (deque->tail > deque->head)
+    {
+        *task = deque->tasks[deque->head % deque->capacity];
+        deque->head++;
+        found = true;
+    }
+
+    pthread_mutex_unlock(&deque->lock);
+
+    return found;
+}
+
+static bool RunOneTask(void)
+{
+    Task_t task;
+    bool found = PopTask(&deques[threadIndex], &task);
+
+    for (size_t i = 1; !found && i < threadCount; i++)
+    {
+        found = StealTask(&deques[(threadIndex + i) % threadCount], &task);
+    }
+
+    if (!found)
+    {
+        return false;
+    }
+
+    atomic_fetch_sub(&queuedTasks, 1);
+
+    task.function(task.argument);
+
+    atomic_fetch_sub(&task.group->pending, 1);
+
+    return true;
+}
+
+static void *WorkerMain(void *argument)
+{
+    threadIndex = (size_t)argument;
+
+    while (atomic_load(&running))
+    {
+        if (RunOneTask())
+        {
+            continue;
+        }
+
+        pthread_mutex_lock(&sleepLock);
+
+        while (atomic_load(&running) && atomic_load(&queuedTasks) == 0)
+        {
+            pthread_cond_wait(&sleepCondition, &sleepLock);
+        }
+
+        pthread_mutex_unlock(&sleepLock);
+    }
+
+    return NULL;
+}
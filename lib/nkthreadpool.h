@@ -0,0 +1,65 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkthreadpool.h
+** Module       :  nanoview
+** Author       :  SH
+** Created      :  2025-09-13 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Small work-stealing thread pool used by the
+**                 parallel measure pass (NANOVIEW_PARALLEL)
+**
+***************************************************************/
+
+#ifndef NKTHREADPOOL_H
+#define NKTHREADPOOL_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_THREAD_POOL_MAX_THREADS 64
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef void (*nkTaskFunction_t)(void *argument);
+
+/* tracks a batch of submitted tasks so the submitter can join them */
+typedef struct
+{
+    atomic_size_t pending;
+} nkTaskGroup_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* threadCount includes the calling thread, so threadCount - 1 workers are
+   started. If only some start the pool runs with those; if none do it
+   stays stopped and false is returned. */
+bool nkThreadPool_Start(size_t threadCount);
+void nkThreadPool_Stop(void);
+size_t nkThreadPool_ThreadCount(void);
+
+void nkThreadPool_Submit(nkTaskGroup_t *group, nkTaskFunction_t function, void *argument);
+
+/* runs queued tasks (stealing if needed) until every task in the group is done */
+void nkThreadPool_Wait(nkTaskGroup_t *group);
+
+/* recursive lock serializing work that isn't thread-safe */
+void nkThreadPool_LockSerial(void);
+void nkThreadPool_UnlockSerial(void);
+
+#endif /* NKTHREADPOOL_H */
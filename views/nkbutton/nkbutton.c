@@ -36,12 +36,16 @@
 ** MARK: STATIC VARIABLES
 ***************************************************************/
 
+static nkStyle_t defaultStyle;
+static bool defaultStyleCreated = false;
+
 /***************************************************************
 ** MARK: STATIC FUNCTION DEFS
 ***************************************************************/
 
-static void DrawCallback(nkView_t *view, nkDrawContext_t *context);
-static void MeasureCallback(nkView_t *view, nkDrawContext_t *context);
+static void RecordCallback(nkView_t *view, nkDisplayList_t *list);
+static nkSize_t MeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context);
+static const nkStyle_t *CurrentStyle(const nkButton_t *button);
 
 static void HoverCallback(nkView_t *view, nkPointerHover_t hover);
 
@@ -60,14 +64,15 @@ bool nkButton_Create(nkButton_t *button)
 
     /* Set default values */
     button->text = NULL;
+    button->style = NULL;
     button->onClick = NULL;
 
     button->view.backgroundColor = NK_COLOR_TRANSPARENT;
 
     button->view.data = button;
     button->view.dataSize = sizeof(nkButton_t);
-    button->view.drawCallback = DrawCallback;
-    button->view.measureCallback = MeasureCallback;
+    button->view.recordCallback = RecordCallback;
+    button->view.measureSizeCallback = MeasureCallback;
 
     button->view.pointerHoverCallback = HoverCallback;
     button->view.capturePointerHover = true; /* Enable pointer hover capture */
@@ -77,11 +82,8 @@ bool nkButton_Create(nkButton_t *button)
     button->isHighlighted = false; /* Initial state is not highlighted */
     button->isPressed = false; /* Initial state is not pressed */
 
-    button->background = nkColor_FromHexRGB(0xF0F0F0);
-    button->padding = nkThickness_FromConstant(5.0f);
     button->view.margin = nkThickness_FromConstant(5.0f);
 
-
     button->view.verticalAlignment = ALIGNMENT_CENTER; /* Center vertically */
     button->view.horizontalAlignment = ALIGNMENT_MIDDLE; /* Center horizontally */
 
@@ -93,11 +95,60 @@ void nkButton_Destroy(nkButton_t *button)
 
 }
 
+const nkStyle_t *nkButton_DefaultStyle(void)
+{
+    if (!defaultStyleCreated)
+    {
+        nkStyle_Create(&defaultStyle, NULL, nkThickness_FromConstant(5.0f), 5.0f, NK_COLOR_BLACK, nkColor_FromHexRGB(0xF0F0F0));
+        defaultStyleCreated = true;
+    }
+
+    return &defaultStyle;
+}
+
+void nkButton_SetStyle(nkButton_t *button, const nkStyle_t *style)
+{
+    if (button == NULL || style == button->style)
+    {
+        return;
+    }
+
+    const nkStyle_t *previous = CurrentStyle(button);
+
+    button->style = style;
+
+    if (nkStyle_ChangesMetrics(previous, CurrentStyle(button)))
+    {
+        nkView_InvalidateMeasure(&button->view);
+    }
+
+    nkView_InvalidateVisual(&button->view);
+}
+
+void nkButton_SetText(nkButton_t *button, const char *text)
+{
+    if (button == NULL)
+    {
+        return;
+    }
+
+    /* another copy of the same string */
+    if (text != button->text && text != NULL && button->text != NULL && strcmp(text, button->text) == 0)
+    {
+        button->text = text;
+        return;
+    }
+
+    button->text = text;
+    nkView_InvalidateMeasure(&button->view);
+    nkView_InvalidateVisual(&button->view);
+}
+
 /***************************************************************
 ** MARK: STATIC FUNCTIONS
 ***************************************************************/
 
-static void DrawCallback(nkView_t *view, nkDrawContext_t *context)
+static void RecordCallback(nkView_t *view, nkDisplayList_t *list)
 {
     nkButton_t *button = (nkButton_t *)view->data;
 
@@ -106,87 +157,72 @@ static void DrawCallback(nkView_t *view, nkDrawContext_t *context)
         return;
     }
 
-    if (button->background.a > 0.001f)
-    {
-        nkColor_t baseColor = button->background;
-
-        nkColor_t borderTop = button->background;
-        nkColor_t borderBottom = button->background;
+    const nkStyle_t *style = CurrentStyle(button);
 
-        if (button->isHighlighted)
-        {
-            baseColor = nkColor_Lighten(baseColor, 0.5f);
-        }
-
-        if (button->isPressed)
-        {
-            borderTop = nkColor_Darken(baseColor, 0.0625f);
-            borderBottom = nkColor_Lighten(baseColor, 0.75f);
-        }
-        else
-        {
-            borderTop = nkColor_Lighten(baseColor, 0.75);
-            borderBottom = nkColor_Darken(baseColor, 0.125f);
-        }
+    if (style->background.a > 0.001f)
+    {
+        const nkStyleColors_t *colors = &style->states[nkStyle_State(button->isHighlighted, button->isPressed)];
 
-        nkDraw_SetColorGradient(
-            context, 
-            nkColor_Lighten(baseColor, 0.5f),
-            baseColor, 
+        nkDisplayList_SetColorGradient(
+            list, 
+            colors->fillStart,
+            colors->fillEnd, 
             (float)M_PI / 16.0f, 
             view->frame.x, view->frame.y, 
             view->frame.width, view->frame.height
         );
 
-        nkDraw_RoundedRect(
-            context, 
+        nkDisplayList_RoundedRect(
+            list, 
             view->frame.x, view->frame.y, 
             view->frame.width, view->frame.height, 
-            5.0f
+            style->cornerRadius
         );
 
-        nkDraw_SetStrokeWidth(context, 1.0f);
+        nkDisplayList_SetStrokeWidth(list, 1.0f);
 
-        nkDraw_SetStrokeColorGradient(
-            context, 
-            borderTop, 
-            borderBottom, 
+        nkDisplayList_SetStrokeColorGradient(
+            list, 
+            colors->borderStart, 
+            colors->borderEnd, 
             (float)M_PI / 16.0f, 
             view->frame.x, view->frame.y, 
             view->frame.width, view->frame.height
         );
 
-        nkDraw_RoundedRectPath(
-            context, 
+        nkDisplayList_RoundedRectPath(
+            list, 
             view->frame.x, view->frame.y, 
             view->frame.width, view->frame.height, 
-            5.0f
+            style->cornerRadius
         );
 
     }
 
     if (button->text)
     {
-        nkDraw_SetColor(context, NK_COLOR_BLACK);
-        nkDraw_Text(context, button->font, button->text, view->frame.x + button->padding.left, view->frame.y + 12.0f + button->padding.top);
+        nkDisplayList_SetColor(list, style->foreground);
+        nkDisplayList_Text(list, style->font, button->text, view->frame.x + style->padding.left, view->frame.y + 12.0f + style->padding.top);
     }
 
 }
 
-static void MeasureCallback(nkView_t *view, nkDrawContext_t *context)
+static nkSize_t MeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context)
 {
     nkButton_t *button = (nkButton_t *)view->data;
 
     if (button == NULL)
     {
-        return;
+        return view->sizeRequest;
     }
 
-    nkRect_t textFrame = nkDraw_MeasureText(context, button->font, button->text ? button->text : "");
-
-    view->sizeRequest.width = textFrame.width + button->padding.left + button->padding.right;
-    view->sizeRequest.height = textFrame.height + button->padding.top + button->padding.bottom;
+    const nkStyle_t *style = CurrentStyle(button);
+    nkRect_t textFrame = nkView_MeasureText(context, style->font, button->text ? button->text : "");
 
+    return (nkSize_t){
+        textFrame.width + style->padding.left + style->padding.right,
+        textFrame.height + style->padding.top + style->padding.bottom
+    };
 }
 
 static void HoverCallback(nkView_t *view, nkPointerHover_t hover)
@@ -198,6 +234,8 @@ static void HoverCallback(nkView_t *view, nkPointerHover_t hover)
         return;
     }
 
+    bool wasHighlighted = button->isHighlighted;
+
     if (hover == HOVER_BEGIN)
     {
         button->isHighlighted = true;
@@ -206,6 +244,11 @@ static void HoverCallback(nkView_t *view, nkPointerHover_t hover)
     {
         button->isHighlighted = false;
     }
+
+    if (button->isHighlighted != wasHighlighted)
+    {
+        nkView_InvalidateVisual(view);
+    }
 }
 
 static void PointerActionCallback(nkView_t *view, nkPointerAction_t action, nkPointerEvent_t event, float x, float y)
@@ -217,6 +260,8 @@ static void PointerActionCallback(nkView_t *view, nkPointerAction_t action, nkPo
         return;
     }
 
+    bool wasPressed = button->isPressed;
+
     if (event == POINTER_EVENT_BEGIN)
     {
         button->isPressed = true;
@@ -234,4 +279,22 @@ static void PointerActionCallback(nkView_t *view, nkPointerAction_t action, nkPo
     {
         button->isPressed = false;
     }
+
+    if (button->isPressed != wasPressed)
+    {
+        nkView_InvalidateVisual(view);
+    }
+}
+
+/* its own style, else the theme's, else the default */
+static const nkStyle_t *CurrentStyle(const nkButton_t *button)
+{
+    const nkTheme_t *theme = nkTheme_Current();
+
+    if (button->style != NULL)
+    {
+        return button->style;
+    }
+
+    return (theme != NULL && theme->button != NULL) ? theme->button : nkButton_DefaultStyle();
 }
\ No newline at end of file
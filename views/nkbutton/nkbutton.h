@@ -20,6 +20,8 @@
 
 #include <nanoview.h>
 
+#include <views/nkstyle/nkstyle.h>
+
 /***************************************************************
 ** MARK: CONSTANTS & MACROS
 ***************************************************************/
@@ -36,15 +38,9 @@ typedef struct
 {
     nkView_t view;          /* view */
 
-    nkThickness_t padding;  /* padding around the button contents */
-
-    const char *text;       /* button text */
-    nkFont_t *font;         /* button font */
-    nkColor_t foreground; 
+    const char *text;       /* button text, see nkButton_SetText */
+    const nkStyle_t *style; /* font, padding and colours, shared, or NULL to follow the theme; see nkButton_SetStyle */
 
-    float cornerRadius;     /* corner radius for rounded buttons */
-    nkColor_t background;   /* button background color */
-    
     ButtonCallback_t onClick; /* callback for button click */
 
     /* state */
@@ -61,4 +57,16 @@ bool nkButton_Create(nkButton_t *button);
 
 void nkButton_Destroy(nkButton_t *button);
 
+/* the style buttons follow when the theme (see nkTheme_Set) sets none */
+const nkStyle_t *nkButton_DefaultStyle(void);
+
+/* swaps the style, NULL to follow the theme again, measuring again only if
+   the font or padding differ */
+void nkButton_SetStyle(nkButton_t *button, const nkStyle_t *style);
+
+/* Sets the text, which isn't copied, and measures again. Changing the
+   characters text points to in place needs nkButton_SetText with the same
+   pointer, or nkView_InvalidateMeasure, to be seen. */
+void nkButton_SetText(nkButton_t *button, const char *text);
+
 #endif /* NKBUTTON_H */
\ No newline at end of file
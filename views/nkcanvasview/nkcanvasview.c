@@ -0,0 +1,741 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkcanvasview.c
+** Module       :  views
+** Author       :  SH
+** Created      :  2025-09-10 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Canvas View
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkcanvasview.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define MAX_CELLS_PER_RECT 64 /* larger rects go in the large list */
+#define MIN_BUCKETS 64
+#define MAX_CELL_COORD 1073741824.0f /* keeps cell co-ordinates within int32_t */
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static nkSize_t MeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context);
+static void ArrangeCallback(nkView_t *view, nkDrawContext_t *context);
+static size_t QueryChildrenCallback(nkView_t *view, nkRect_t region, nkView_t *const **children);
+
+static bool IndexCurrent(nkCanvasView_t *canvasView);
+static bool Rebuild(nkCanvasView_t *canvasView);
+static bool Insert(nkCanvasView_t *canvasView, uint32_t entry);
+static void Remove(nkCanvasView_t *canvasView, uint32_t entry);
+static bool CellRange(nkCanvasView_t *canvasView, nkRect_t rect, int32_t *x0, int32_t *y0, int32_t *x1, int32_t *y1);
+static nkCanvasBucket_t *GetBucket(nkCanvasView_t *canvasView, int32_t cellX, int32_t cellY);
+static size_t QueryInto(nkCanvasView_t *canvasView, nkRect_t region, nkCanvasResults_t *results);
+static bool AddResult(nkCanvasView_t *canvasView, nkCanvasResults_t *results, uint32_t entry, nkRect_t area);
+static void PlaceEntry(nkCanvasView_t *canvasView, nkCanvasEntry_t *entry);
+static void MeasureEntry(nkCanvasEntry_t *entry, nkDrawContext_t *context);
+static void GrowExtent(nkCanvasView_t *canvasView, nkRect_t rect);
+static bool Reserve(void **array, size_t *capacity, size_t needed, size_t elementSize);
+static int CompareEntries(const void *a, const void *b);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool nkCanvasView_Create(nkCanvasView_t *canvasView)
+{
+    if (!nkView_Create(&canvasView->view, "CanvasView"))
+    {
+        return false;
+    }
+
+    canvasView->view.measureSizeCallback = MeasureCallback;
+    canvasView->view.arrangeCallback = ArrangeCallback;
+    canvasView->view.queryChildrenCallback = QueryChildrenCallback;
+    canvasView->view.measureThreadSafe = true; /* measure updates the canvas's index and measures its children, none shared with other tasks */
+
+    /* Set default values */
+    canvasView->offset = (nkPoint_t){0, 0};
+    canvasView->zoom = 1.0f;
+    canvasView->cellSize = NK_CANVAS_DEFAULT_CELL_SIZE;
+
+    canvasView->entries = NULL;
+    canvasView->entryCount = 0;
+    canvasView->buckets = NULL;
+    canvasView->bucketCount = 0;
+    canvasView->large = NULL;
+    canvasView->largeCount = 0;
+    canvasView->largeCapacity = 0;
+    canvasView->pending = NULL;
+    canvasView->pendingCount = 0;
+    canvasView->pendingCapacity = 0;
+
+    canvasView->extent = (nkRect_t){0, 0, 0, 0};
+    canvasView->indexedStructureVersion = 0;
+    canvasView->indexValid = false;
+    canvasView->needsMeasureAll = false;
+
+    canvasView->placementVersion = 0;
+    canvasView->queryStamp = 0;
+
+    canvasView->walkResults = (nkCanvasResults_t){NULL, NULL, 0, 0};
+    canvasView->results = (nkCanvasResults_t){NULL, NULL, 0, 0};
+
+    canvasView->view.data = canvasView;
+    canvasView->view.dataSize = sizeof(nkCanvasView_t);
+
+    canvasView->view.clipToBounds = true; /* Clip to bounds by default */
+
+    return true;
+}
+
+void nkCanvasView_Destroy(nkCanvasView_t *canvasView)
+{
+    if (canvasView == NULL)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < canvasView->bucketCount; i++)
+    {
+        free(canvasView->buckets[i].items);
+    }
+
+    free(canvasView->buckets);
+    free(canvasView->entries);
+    free(canvasView->large);
+    free(canvasView->pending);
+    free(canvasView->walkResults.entries);
+    free(canvasView->walkResults.views);
+    free(canvasView->results.entries);
+    free(canvasView->results.views);
+
+    canvasView->buckets = NULL;
+    canvasView->bucketCount = 0;
+    canvasView->entries = NULL;
+    canvasView->entryCount = 0;
+    canvasView->large = NULL;
+    canvasView->largeCount = 0;
+    canvasView->largeCapacity = 0;
+    canvasView->pending = NULL;
+    canvasView->pendingCount = 0;
+    canvasView->pendingCapacity = 0;
+    canvasView->walkResults = (nkCanvasResults_t){NULL, NULL, 0, 0};
+    canvasView->results = (nkCanvasResults_t){NULL, NULL, 0, 0};
+    canvasView->indexValid = false;
+}
+
+void nkCanvasView_SetChildRect(nkCanvasView_t *canvasView, nkView_t *child, nkRect_t rect)
+{
+    if (canvasView == NULL || child == NULL)
+    {
+        return;
+    }
+
+    child->canvasRect = rect;
+
+    if (child->parent != &canvasView->view)
+    {
+        return;
+    }
+
+    /* a stale index picks the rect up when it is rebuilt */
+    if (IndexCurrent(canvasView))
+    {
+        uint32_t index = (uint32_t)child->containerIndex;
+        nkCanvasEntry_t *entry = &canvasView->entries[index];
+
+        Remove(canvasView, index);
+        entry->rect = rect;
+
+        if (!Insert(canvasView, index))
+        {
+            canvasView->indexValid = false;
+        }
+
+        entry->placedVersion = canvasView->placementVersion - 1;
+        GrowExtent(canvasView, rect);
+
+        if (Reserve((void **)&canvasView->pending, &canvasView->pendingCapacity, canvasView->pendingCount + 1, sizeof(uint32_t)))
+        {
+            canvasView->pending[canvasView->pendingCount++] = index;
+        }
+        else
+        {
+            canvasView->needsMeasureAll = true;
+        }
+    }
+
+    nkView_InvalidateMeasure(&canvasView->view);
+    nkView_InvalidateArrange(&canvasView->view);
+}
+
+void nkCanvasView_SetOffset(nkCanvasView_t *canvasView, nkPoint_t offset)
+{
+    if (canvasView == NULL)
+    {
+        return;
+    }
+
+    canvasView->offset = offset;
+    nkView_InvalidateArrange(&canvasView->view);
+}
+
+void nkCanvasView_SetZoom(nkCanvasView_t *canvasView, float zoom)
+{
+    if (canvasView == NULL || !(zoom > 0.0f))
+    {
+        return;
+    }
+
+    canvasView->zoom = zoom;
+    nkView_InvalidateArrange(&canvasView->view);
+}
+
+size_t nkCanvasView_Query(nkCanvasView_t *canvasView, nkRect_t region, nkView_t *const **children)
+{
+    *children = NULL;
+
+    if (canvasView == NULL)
+    {
+        return 0;
+    }
+
+    size_t count = QueryInto(canvasView, region, &canvasView->results);
+
+    *children = canvasView->results.views;
+
+    return count;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static size_t QueryInto(nkCanvasView_t *canvasView, nkRect_t region, nkCanvasResults_t *results)
+{
+    if (!IndexCurrent(canvasView) && !Rebuild(canvasView))
+    {
+        return 0;
+    }
+
+    /* window co-ordinates to canvas co-ordinates */
+    nkRect_t frame = canvasView->view.frame;
+    float zoom = canvasView->zoom;
+
+    nkRect_t area = {
+        (region.x - frame.x) / zoom + canvasView->offset.x,
+        (region.y - frame.y) / zoom + canvasView->offset.y,
+        region.width / zoom,
+        region.height / zoom
+    };
+
+    if (++canvasView->queryStamp == 0)
+    {
+        for (size_t i = 0; i < canvasView->entryCount; i++)
+        {
+            canvasView->entries[i].stamp = 0;
+        }
+
+        canvasView->queryStamp = 1;
+    }
+
+    results->count = 0;
+
+    int32_t x0, y0, x1, y1;
+    bool bounded = CellRange(canvasView, area, &x0, &y0, &x1, &y1);
+
+    if (bounded && (uint64_t)(x1 - x0 + 1) * (uint64_t)(y1 - y0 + 1) <= canvasView->bucketCount)
+    {
+        for (int32_t cellY = y0; cellY <= y1; cellY++)
+        {
+            for (int32_t cellX = x0; cellX <= x1; cellX++)
+            {
+                nkCanvasBucket_t *bucket = GetBucket(canvasView, cellX, cellY);
+
+                for (uint32_t i = 0; i < bucket->count; i++)
+                {
+                    nkCanvasCellItem_t *item = &bucket->items[i];
+
+                    if (item->cellX == cellX && item->cellY == cellY && !AddResult(canvasView, results, item->entry, area))
+                    {
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        /* the area covers more cells than there are buckets */
+        for (size_t b = 0; b < canvasView->bucketCount; b++)
+        {
+            nkCanvasBucket_t *bucket = &canvasView->buckets[b];
+
+            for (uint32_t i = 0; i < bucket->count; i++)
+            {
+                if (!AddResult(canvasView, results, bucket->items[i].entry, area))
+                {
+                    return 0;
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < canvasView->largeCount; i++)
+    {
+        if (!AddResult(canvasView, results, canvasView->large[i], area))
+        {
+            return 0;
+        }
+    }
+
+    /* entries are in child order, which is draw order */
+    qsort(results->entries, results->count, sizeof(uint32_t), CompareEntries);
+
+    for (size_t i = 0; i < results->count; i++)
+    {
+        nkCanvasEntry_t *entry = &canvasView->entries[results->entries[i]];
+
+        /* children are placed on first sight after a pan, zoom or move */
+        if (entry->placedVersion != canvasView->placementVersion)
+        {
+            PlaceEntry(canvasView, entry);
+        }
+
+        results->views[i] = entry->view;
+    }
+
+    return results->count;
+}
+
+static nkSize_t MeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context)
+{
+
+    nkCanvasView_t *canvasView = (nkCanvasView_t *)view->data;
+
+    if (!canvasView || view->dataSize != sizeof(nkCanvasView_t))
+    {
+        return view->sizeRequest;
+    }
+
+    if (!IndexCurrent(canvasView))
+    {
+        Rebuild(canvasView);
+    }
+
+    /* children are measured against their rect, only when it changes */
+    if (canvasView->needsMeasureAll)
+    {
+        for (size_t i = 0; i < canvasView->entryCount; i++)
+        {
+            MeasureEntry(&canvasView->entries[i], context);
+        }
+
+        canvasView->needsMeasureAll = false;
+    }
+    else
+    {
+        for (size_t i = 0; i < canvasView->pendingCount; i++)
+        {
+            MeasureEntry(&canvasView->entries[canvasView->pending[i]], context);
+        }
+    }
+
+    canvasView->pendingCount = 0;
+
+    /* like a scroll view, the canvas keeps whatever size was requested for it */
+    return view->sizeRequest;
+}
+
+/* every frame goes stale. The arrange pass then queries the visible
+   children, which places them, and the rest are placed as later queries
+   reach them. */
+static void ArrangeCallback(nkView_t *view, nkDrawContext_t *context)
+{
+
+    nkCanvasView_t *canvasView = (nkCanvasView_t *)view->data;
+
+    if (!canvasView || view->dataSize != sizeof(nkCanvasView_t))
+    {
+        return;
+    }
+
+    canvasView->placementVersion++;
+}
+
+static size_t QueryChildrenCallback(nkView_t *view, nkRect_t region, nkView_t *const **children)
+{
+    nkCanvasView_t *canvasView = (nkCanvasView_t *)view->data;
+
+    if (!canvasView || view->dataSize != sizeof(nkCanvasView_t))
+    {
+        *children = NULL;
+        return 0;
+    }
+
+    size_t count = QueryInto(canvasView, region, &canvasView->walkResults);
+
+    *children = canvasView->walkResults.views;
+
+    return count;
+}
+
+static bool IndexCurrent(nkCanvasView_t *canvasView)
+{
+    return canvasView->indexValid && canvasView->indexedStructureVersion == canvasView->view.structureVersion;
+}
+
+/* re-indexes every child, after the child list changed */
+static bool Rebuild(nkCanvasView_t *canvasView)
+{
+    size_t childCount = canvasView->view.childCount;
+
+    canvasView->indexValid = false;
+
+    nkCanvasEntry_t *entries = realloc(canvasView->entries, (childCount > 0 ? childCount : 1) * sizeof(nkCanvasEntry_t));
+
+    if (entries == NULL)
+    {
+        return false;
+    }
+
+    canvasView->entries = entries;
+
+    size_t bucketCount = MIN_BUCKETS;
+
+    while (bucketCount < childCount)
+    {
+        bucketCount *= 2;
+    }
+
+    if (bucketCount != canvasView->bucketCount)
+    {
+        nkCanvasBucket_t *buckets = calloc(bucketCount, sizeof(nkCanvasBucket_t));
+
+        if (buckets == NULL)
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < canvasView->bucketCount; i++)
+        {
+            free(canvasView->buckets[i].items);
+        }
+
+        free(canvasView->buckets);
+
+        canvasView->buckets = buckets;
+        canvasView->bucketCount = bucketCount;
+    }
+    else
+    {
+        for (size_t i = 0; i < bucketCount; i++)
+        {
+            canvasView->buckets[i].count = 0;
+        }
+    }
+
+    canvasView->largeCount = 0;
+    canvasView->pendingCount = 0;
+    canvasView->entryCount = 0;
+
+    uint32_t index = 0;
+
+    for (nkView_t *child = canvasView->view.child; child; child = child->sibling, index++)
+    {
+        canvasView->entries[index] = (nkCanvasEntry_t){child, child->canvasRect, 0, canvasView->placementVersion - 1, UINT32_MAX};
+        child->containerIndex = index;
+        canvasView->entryCount = index + 1;
+
+        if (!Insert(canvasView, index))
+        {
+            return false;
+        }
+
+        if (index == 0)
+        {
+            canvasView->extent = child->canvasRect;
+        }
+        else
+        {
+            GrowExtent(canvasView, child->canvasRect);
+        }
+    }
+
+    if (index == 0)
+    {
+        canvasView->extent = (nkRect_t){0, 0, 0, 0};
+    }
+
+    canvasView->indexedStructureVersion = canvasView->view.structureVersion;
+    canvasView->indexValid = true;
+    canvasView->needsMeasureAll = true;
+
+    return true;
+}
+
+static bool Insert(nkCanvasView_t *canvasView, uint32_t index)
+{
+    nkCanvasEntry_t *entry = &canvasView->entries[index];
+
+    int32_t x0, y0, x1, y1;
+
+    if (!CellRange(canvasView, entry->rect, &x0, &y0, &x1, &y1)
+        || (uint64_t)(x1 - x0 + 1) * (uint64_t)(y1 - y0 + 1) > MAX_CELLS_PER_RECT)
+    {
+        if (!Reserve((void **)&canvasView->large, &canvasView->largeCapacity, canvasView->largeCount + 1, sizeof(uint32_t)))
+        {
+            return false;
+        }
+
+        entry->largeSlot = (uint32_t)canvasView->largeCount;
+        canvasView->large[canvasView->largeCount++] = index;
+
+        return true;
+    }
+
+    for (int32_t cellY = y0; cellY <= y1; cellY++)
+    {
+        for (int32_t cellX = x0; cellX <= x1; cellX++)
+        {
+            nkCanvasBucket_t *bucket = GetBucket(canvasView, cellX, cellY);
+
+            if (bucket->count == bucket->capacity)
+            {
+                uint32_t capacity = (bucket->capacity > 0) ? bucket->capacity * 2 : 4;
+                nkCanvasCellItem_t *items = realloc(bucket->items, capacity * sizeof(nkCanvasCellItem_t));
+
+                if (items == NULL)
+                {
+                    return false;
+                }
+
+                bucket->items = items;
+                bucket->capacity = capacity;
+            }
+
+            bucket->items[bucket->count++] = (nkCanvasCellItem_t){cellX, cellY, index};
+        }
+    }
+
+    return true;
+}
+
+static void Remove(nkCanvasView_t *canvasView, uint32_t index)
+{
+    nkCanvasEntry_t *entry = &canvasView->entries[index];
+
+    if (entry->largeSlot != UINT32_MAX)
+    {
+        uint32_t moved = canvasView->large[--canvasView->largeCount];
+
+        canvasView->large[entry->largeSlot] = moved;
+        canvasView->entries[moved].largeSlot = entry->largeSlot;
+        entry->largeSlot = UINT32_MAX;
+
+        return;
+    }
+
+    int32_t x0, y0, x1, y1;
+    CellRange(canvasView, entry->rect, &x0, &y0, &x1, &y1);
+
+    for (int32_t cellY = y0; cellY <= y1; cellY++)
+    {
+        for (int32_t cellX = x0; cellX <= x1; cellX++)
+        {
+            nkCanvasBucket_t *bucket = GetBucket(canvasView, cellX, cellY);
+
+            for (uint32_t i = 0; i < bucket->count; i++)
+            {
+                nkCanvasCellItem_t *item = &bucket->items[i];
+
+                if (item->entry == index && item->cellX == cellX && item->cellY == cellY)
+                {
+                    *item = bucket->items[--bucket->count];
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/* the cells a rect touches, false if it can't be expressed in cells */
+static bool CellRange(nkCanvasView_t *canvasView, nkRect_t rect, int32_t *x0, int32_t *y0, int32_t *x1, int32_t *y1)
+{
+    float cellSize = canvasView->cellSize;
+
+    float left = floorf(rect.x / cellSize);
+    float top = floorf(rect.y / cellSize);
+    float right = floorf((rect.x + rect.width) / cellSize);
+    float bottom = floorf((rect.y + rect.height) / cellSize);
+
+    /* also rejects NaN */
+    if (!(fabsf(left) < MAX_CELL_COORD && fabsf(top) < MAX_CELL_COORD
+        && fabsf(right) < MAX_CELL_COORD && fabsf(bottom) < MAX_CELL_COORD)
+        || right < left || bottom < top)
+    {
+        return false;
+    }
+
+    *x0 = (int32_t)left;
+    *y0 = (int32_t)top;
+    *x1 = (int32_t)right;
+    *y1 = (int32_t)bottom;
+
+    return true;
+}
+
+static nkCanvasBucket_t *GetBucket(nkCanvasView_t *canvasView, int32_t cellX, int32_t cellY)
+{
+    uint32_t hash = ((uint32_t)cellX * 73856093u) ^ ((uint32_t)cellY * 19349663u);
+
+    return &canvasView->buckets[hash & (canvasView->bucketCount - 1)];
+}
+
+/* adds an entry once per query if its rect touches the area */
+static bool AddResult(nkCanvasView_t *canvasView, nkCanvasResults_t *results, uint32_t index, nkRect_t area)
+{
+    nkCanvasEntry_t *entry = &canvasView->entries[index];
+
+    if (entry->stamp == canvasView->queryStamp)
+    {
+        return true;
+    }
+
+    entry->stamp = canvasView->queryStamp;
+
+    nkRect_t rect = entry->rect;
+
+    if (rect.x > area.x + area.width || area.x > rect.x + rect.width
+        || rect.y > area.y + area.height || area.y > rect.y + rect.height)
+    {
+        return true;
+    }
+
+    size_t capacity = results->capacity;
+
+    if (results->count == capacity)
+    {
+        capacity = (capacity > 0) ? capacity * 2 : 64;
+
+        uint32_t *entries = realloc(results->entries, capacity * sizeof(uint32_t));
+
+        if (entries == NULL)
+        {
+            return false;
+        }
+
+        results->entries = entries;
+
+        nkView_t **views = realloc(results->views, capacity * sizeof(nkView_t *));
+
+        if (views == NULL)
+        {
+            return false;
+        }
+
+        results->views = views;
+        results->capacity = capacity;
+    }
+
+    results->entries[results->count++] = index;
+
+    return true;
+}
+
+static void PlaceEntry(nkCanvasView_t *canvasView, nkCanvasEntry_t *entry)
+{
+    nkRect_t frame = canvasView->view.frame;
+    float zoom = canvasView->zoom;
+
+    nkView_PlaceView(entry->view, (nkRect_t){
+        frame.x + (entry->rect.x - canvasView->offset.x) * zoom,
+        frame.y + (entry->rect.y - canvasView->offset.y) * zoom,
+        entry->rect.width * zoom,
+        entry->rect.height * zoom
+    });
+
+    entry->placedVersion = canvasView->placementVersion;
+}
+
+static void MeasureEntry(nkCanvasEntry_t *entry, nkDrawContext_t *context)
+{
+    nkView_t *child = entry->view;
+
+    nkSize_t available = {
+        fmaxf(0.0f, entry->rect.width - child->margin.left - child->margin.right),
+        fmaxf(0.0f, entry->rect.height - child->margin.top - child->margin.bottom)
+    };
+
+    nkView_Measure(child, available, context);
+}
+
+static void GrowExtent(nkCanvasView_t *canvasView, nkRect_t rect)
+{
+    nkRect_t extent = canvasView->extent;
+
+    float left = fminf(extent.x, rect.x);
+    float top = fminf(extent.y, rect.y);
+    float right = fmaxf(extent.x + extent.width, rect.x + rect.width);
+    float bottom = fmaxf(extent.y + extent.height, rect.y + rect.height);
+
+    canvasView->extent = (nkRect_t){left, top, right - left, bottom - top};
+}
+
+static bool Reserve(void **array, size_t *capacity, size_t needed, size_t elementSize)
+{
+    if (needed <= *capacity)
+    {
+        return true;
+    }
+
+    size_t newCapacity = (*capacity > 0) ? *capacity * 2 : 16;
+
+    while (newCapacity < needed)
+    {
+        newCapacity *= 2;
+    }
+
+    void *newArray = realloc(*array, newCapacity * elementSize);
+
+    if (newArray == NULL)
+    {
+        return false;
+    }
+
+    *array = newArray;
+    *capacity = newCapacity;
+
+    return true;
+}
+
+static int CompareEntries(const void *a, const void *b)
+{
+    uint32_t left = *(const uint32_t *)a;
+    uint32_t right = *(const uint32_t *)b;
+
+    return (left > right) - (left < right);
+}
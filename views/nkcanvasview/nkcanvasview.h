@@ -0,0 +1,122 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkcanvasview.h
+** Module       :  views
+** Author       :  SH
+** Created      :  2025-09-10 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Canvas View header file
+**
+***************************************************************/
+
+#ifndef NKCANVASVIEW_H
+#define NKCANVASVIEW_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <nanoview.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_CANVAS_DEFAULT_CELL_SIZE 256.0f
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    nkView_t *view;
+    nkRect_t rect;              /* canvasRect when last indexed */
+    uint32_t stamp;             /* last query that returned it */
+    uint32_t placedVersion;     /* placementVersion the frame was computed at */
+    uint32_t largeSlot;         /* slot in the large list, UINT32_MAX if indexed by cell */
+} nkCanvasEntry_t;
+
+typedef struct
+{
+    int32_t cellX;
+    int32_t cellY;
+    uint32_t entry;
+} nkCanvasCellItem_t;
+
+typedef struct
+{
+    nkCanvasCellItem_t *items;
+    uint32_t count;
+    uint32_t capacity;
+} nkCanvasBucket_t;
+
+/* one query's children, kept until the next query that uses the same list */
+typedef struct
+{
+    uint32_t *entries;
+    nkView_t **views;
+    size_t count;
+    size_t capacity;
+} nkCanvasResults_t;
+
+typedef struct
+{
+    nkView_t view;              /* view */
+
+    nkPoint_t offset;           /* canvas point shown at the view's top left */
+    float zoom;
+    float cellSize;             /* index cell size in canvas units */
+
+    /* spatial index over the children's canvasRect: a uniform grid of
+       cells, hashed into buckets so the canvas is unbounded */
+    nkCanvasEntry_t *entries;   /* one per child, in child order */
+    size_t entryCount;
+    nkCanvasBucket_t *buckets;
+    size_t bucketCount;         /* power of two */
+    uint32_t *large;            /* entries spanning too many cells, always tested */
+    size_t largeCount;
+    size_t largeCapacity;
+    uint32_t *pending;          /* entries whose rect changed since the last measure */
+    size_t pendingCount;
+    size_t pendingCapacity;
+
+    nkRect_t extent;            /* bounds of every rect in canvas units, only grows between rebuilds */
+    uint32_t indexedStructureVersion;
+    bool indexValid;
+    bool needsMeasureAll;       /* children were re-indexed but not yet measured */
+
+    uint32_t placementVersion;  /* bumped whenever every child frame may be stale */
+    uint32_t queryStamp;
+
+    /* the arrange, render and hit test walks list children through walkResults,
+       so nkCanvasView_Query called from a callback during a walk doesn't
+       overwrite the list being walked */
+    nkCanvasResults_t walkResults;
+    nkCanvasResults_t results;
+} nkCanvasView_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* Children are placed at their canvasRect, relative to the canvas origin
+   and scaled by zoom. Only the children that can be seen are placed,
+   drawn and hit tested, so work follows what is on screen. */
+bool nkCanvasView_Create(nkCanvasView_t *canvasView);
+
+void nkCanvasView_Destroy(nkCanvasView_t *canvasView);
+
+/* moves a child, updating the index in place */
+void nkCanvasView_SetChildRect(nkCanvasView_t *canvasView, nkView_t *child, nkRect_t rect);
+
+void nkCanvasView_SetOffset(nkCanvasView_t *canvasView, nkPoint_t offset);
+void nkCanvasView_SetZoom(nkCanvasView_t *canvasView, float zoom);
+
+/* children that may intersect region (window co-ordinates), in draw order.
+   The list stays valid until the next nkCanvasView_Query on this canvas. */
+size_t nkCanvasView_Query(nkCanvasView_t *canvasView, nkRect_t region, nkView_t *const **children);
+
+#endif /* NKCANVASVIEW_H */
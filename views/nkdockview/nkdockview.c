@@ -38,7 +38,7 @@
 ** MARK: STATIC FUNCTION DEFS
 ***************************************************************/
 
-static void MeasureCallback(nkView_t *view, nkDrawContext_t *context);
+static nkSize_t MeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context);
 static void ArrangeCallback(nkView_t *view, nkDrawContext_t *context);
 
 /***************************************************************
@@ -52,8 +52,9 @@ bool nkDockView_Create(nkDockView_t *dockView)
         return false;
     }
 
-    dockView->view.measureCallback = MeasureCallback;
+    dockView->view.measureSizeCallback = MeasureCallback;
     dockView->view.arrangeCallback = ArrangeCallback;
+    dockView->view.measureThreadSafe = true; /* measuring docked children stays inside the dock's own subtree */
 
     /* Set default values */
     dockView->lastChildFill = true;
@@ -74,24 +75,31 @@ void nkDockPanel_Destroy(nkDockView_t *dockView)
 ** MARK: STATIC FUNCTIONS
 ***************************************************************/
 
-static void MeasureCallback(nkView_t *view, nkDrawContext_t *context)
+static nkSize_t MeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context)
 {
 
     nkSize_t total = {0, 0};
     nkView_t *child = view->child;
 
     nkSize_t largestRequest = {view->sizeRequest.width, view->sizeRequest.height};
+    nkSize_t remaining = available; /* space left once earlier children are docked */
 
     while (child)
     {
 
-        nkSize_t marginRequest = child->sizeRequest;
+        nkSize_t childAvailable = {
+            fmaxf(0.0f, remaining.width - child->margin.left - child->margin.right),
+            fmaxf(0.0f, remaining.height - child->margin.top - child->margin.bottom)
+        };
+
+        nkSize_t marginRequest = nkView_Measure(child, childAvailable, context);
         marginRequest.width += child->margin.left + child->margin.right;
         marginRequest.height += child->margin.top + child->margin.bottom;
 
         if (child->dockPosition == DOCK_POSITION_LEFT || child->dockPosition == DOCK_POSITION_RIGHT)
         {
             total.width += marginRequest.width;
+            remaining.width = fmaxf(0.0f, remaining.width - marginRequest.width);
             
             if (marginRequest.height > total.height && marginRequest.height > largestRequest.height)
             {
@@ -101,6 +109,7 @@ static void MeasureCallback(nkView_t *view, nkDrawContext_t *context)
         else if (child->dockPosition == DOCK_POSITION_TOP || child->dockPosition == DOCK_POSITION_BOTTOM)
         {
             total.height += marginRequest.height;
+            remaining.height = fmaxf(0.0f, remaining.height - marginRequest.height);
             
             if (marginRequest.width > total.width && marginRequest.width > largestRequest.width)
             {
@@ -121,7 +130,7 @@ static void MeasureCallback(nkView_t *view, nkDrawContext_t *context)
         total.height = largestRequest.height;
     }
 
-    view->sizeRequest = total;
+    return total;
 }
 
 static void ArrangeCallback(nkView_t *view, nkDrawContext_t *context)
@@ -0,0 +1,449 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkgridview.c
+** Module       :  views
+** Author       :  SH
+** Created      :  2025-09-08 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Grid View
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkgridview.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static nkSize_t MeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context);
+static void ArrangeCallback(nkView_t *view, nkDrawContext_t *context);
+
+static bool SetTracks(nkGridTrack_t **tracks, size_t *trackCount, const nkGridTrack_t *definitions, size_t count);
+static void PrepareTracks(nkGridTrack_t *tracks, size_t count);
+static float SpanAvailable(const nkGridTrack_t *tracks, size_t first, size_t last);
+static void FitSpan(nkGridTrack_t *tracks, size_t first, size_t last, float request);
+static float TracksTotal(nkGridTrack_t *tracks, size_t count);
+static void SolveTracks(nkGridTrack_t *tracks, size_t count, float length);
+static void GetSpan(size_t index, size_t span, size_t count, size_t *first, size_t *last);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+nkGridTrack_t nkGridTrack_Fixed(float size)
+{
+    return (nkGridTrack_t){.type = GRID_TRACK_FIXED, .value = size};
+}
+
+nkGridTrack_t nkGridTrack_Auto(void)
+{
+    return (nkGridTrack_t){.type = GRID_TRACK_AUTO, .value = 0.0f};
+}
+
+nkGridTrack_t nkGridTrack_Star(float weight)
+{
+    return (nkGridTrack_t){.type = GRID_TRACK_STAR, .value = weight};
+}
+
+bool nkGridView_Create(nkGridView_t *gridView)
+{
+    if (!nkView_Create(&gridView->view, "GridView"))
+    {
+        return false;
+    }
+
+    gridView->view.measureSizeCallback = MeasureCallback;
+    gridView->view.arrangeCallback = ArrangeCallback;
+    gridView->view.measureThreadSafe = true; /* measure writes the grid's tracks and measures its cells, all inside this subtree */
+
+    /* Set default values */
+    gridView->rows = NULL;
+    gridView->rowCount = 0;
+    gridView->columns = NULL;
+    gridView->columnCount = 0;
+    gridView->solvedSize = (nkSize_t){0, 0};
+    gridView->tracksValid = false;
+
+    gridView->view.data = gridView;
+    gridView->view.dataSize = sizeof(nkGridView_t);
+
+    return nkGridView_SetRows(gridView, NULL, 0) && nkGridView_SetColumns(gridView, NULL, 0);
+}
+
+void nkGridView_Destroy(nkGridView_t *gridView)
+{
+    if (gridView == NULL)
+    {
+        return;
+    }
+
+    free(gridView->rows);
+    free(gridView->columns);
+
+    gridView->rows = NULL;
+    gridView->rowCount = 0;
+    gridView->columns = NULL;
+    gridView->columnCount = 0;
+}
+
+/* an empty list gives a single star track */
+bool nkGridView_SetRows(nkGridView_t *gridView, const nkGridTrack_t *rows, size_t count)
+{
+    if (gridView == NULL || !SetTracks(&gridView->rows, &gridView->rowCount, rows, count))
+    {
+        return false;
+    }
+
+    gridView->tracksValid = false;
+    nkView_InvalidateMeasure(&gridView->view);
+
+    return true;
+}
+
+bool nkGridView_SetColumns(nkGridView_t *gridView, const nkGridTrack_t *columns, size_t count)
+{
+    if (gridView == NULL || !SetTracks(&gridView->columns, &gridView->columnCount, columns, count))
+    {
+        return false;
+    }
+
+    gridView->tracksValid = false;
+    nkView_InvalidateMeasure(&gridView->view);
+
+    return true;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+/* Children in a single track set that track's content. Spanning children
+   are fitted afterwards against those contents, each growing only the last
+   flexible track of its span, so every child is visited at most twice and
+   every track a constant number of times. */
+static nkSize_t MeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context)
+{
+
+    nkGridView_t *gridView = (nkGridView_t *)view->data;
+
+    if (!gridView || view->dataSize != sizeof(nkGridView_t))
+    {
+        return view->sizeRequest;
+    }
+
+    nkGridTrack_t *rows = gridView->rows;
+    nkGridTrack_t *columns = gridView->columns;
+
+    PrepareTracks(rows, gridView->rowCount);
+    PrepareTracks(columns, gridView->columnCount);
+
+    bool hasSpans = false;
+    nkView_t *child = view->child;
+
+    while (child)
+    {
+        size_t row, rowLast, column, columnLast;
+        GetSpan(child->gridLocation.Row, child->gridLocation.RowSpan, gridView->rowCount, &row, &rowLast);
+        GetSpan(child->gridLocation.Column, child->gridLocation.ColumnSpan, gridView->columnCount, &column, &columnLast);
+
+        /* children are only constrained by spans made of fixed tracks */
+        nkSize_t childAvailable = {
+            fmaxf(0.0f, SpanAvailable(columns, column, columnLast) - child->margin.left - child->margin.right),
+            fmaxf(0.0f, SpanAvailable(rows, row, rowLast) - child->margin.top - child->margin.bottom)
+        };
+
+        nkSize_t marginRequest = nkView_Measure(child, childAvailable, context);
+        marginRequest.width += child->margin.left + child->margin.right;
+        marginRequest.height += child->margin.top + child->margin.bottom;
+
+        if (column == columnLast)
+        {
+            columns[column].content = fmaxf(columns[column].content, marginRequest.width);
+        }
+
+        if (row == rowLast)
+        {
+            rows[row].content = fmaxf(rows[row].content, marginRequest.height);
+        }
+
+        hasSpans = hasSpans || column != columnLast || row != rowLast;
+
+        child = child->sibling;
+    }
+
+    if (hasSpans)
+    {
+        /* measureEnd becomes the prefix of single-track extents */
+        TracksTotal(rows, gridView->rowCount);
+        TracksTotal(columns, gridView->columnCount);
+
+        for (child = view->child; child; child = child->sibling)
+        {
+            size_t row, rowLast, column, columnLast;
+            GetSpan(child->gridLocation.Row, child->gridLocation.RowSpan, gridView->rowCount, &row, &rowLast);
+            GetSpan(child->gridLocation.Column, child->gridLocation.ColumnSpan, gridView->columnCount, &column, &columnLast);
+
+            if (column != columnLast)
+            {
+                FitSpan(columns, column, columnLast, child->sizeRequest.width + child->margin.left + child->margin.right);
+            }
+
+            if (row != rowLast)
+            {
+                FitSpan(rows, row, rowLast, child->sizeRequest.height + child->margin.top + child->margin.bottom);
+            }
+        }
+    }
+
+    nkSize_t total = {
+        TracksTotal(columns, gridView->columnCount),
+        TracksTotal(rows, gridView->rowCount)
+    };
+
+    /* the solved sizes stay valid while no track's content moves */
+    for (size_t i = 0; i < gridView->rowCount && gridView->tracksValid; i++)
+    {
+        gridView->tracksValid = rows[i].content == rows[i].solvedContent;
+    }
+
+    for (size_t i = 0; i < gridView->columnCount && gridView->tracksValid; i++)
+    {
+        gridView->tracksValid = columns[i].content == columns[i].solvedContent;
+    }
+
+    return total;
+}
+
+static void ArrangeCallback(nkView_t *view, nkDrawContext_t *context)
+{
+
+    nkGridView_t *gridView = (nkGridView_t *)view->data;
+
+    if (!gridView || view->dataSize != sizeof(nkGridView_t))
+    {
+        return;
+    }
+
+    nkRect_t frame = view->frame;
+
+    if (!gridView->tracksValid || gridView->solvedSize.width != frame.width || gridView->solvedSize.height != frame.height)
+    {
+        SolveTracks(gridView->rows, gridView->rowCount, frame.height);
+        SolveTracks(gridView->columns, gridView->columnCount, frame.width);
+
+        gridView->solvedSize = (nkSize_t){frame.width, frame.height};
+        gridView->tracksValid = true;
+    }
+
+    nkGridTrack_t *rows = gridView->rows;
+    nkGridTrack_t *columns = gridView->columns;
+    nkView_t *child = view->child;
+
+    while (child)
+    {
+        size_t row, rowLast, column, columnLast;
+        GetSpan(child->gridLocation.Row, child->gridLocation.RowSpan, gridView->rowCount, &row, &rowLast);
+        GetSpan(child->gridLocation.Column, child->gridLocation.ColumnSpan, gridView->columnCount, &column, &columnLast);
+
+        nkRect_t childRect = {
+            frame.x + columns[column].offset,
+            frame.y + rows[row].offset,
+            columns[columnLast].offset + columns[columnLast].size - columns[column].offset,
+            rows[rowLast].offset + rows[rowLast].size - rows[row].offset
+        };
+
+        nkView_PlaceView(child, childRect);
+
+        child = child->sibling;
+    }
+}
+
+static bool SetTracks(nkGridTrack_t **tracks, size_t *trackCount, const nkGridTrack_t *definitions, size_t count)
+{
+    bool defined = (count > 0 && definitions != NULL);
+    size_t allocated = defined ? count : 1;
+    nkGridTrack_t *newTracks = malloc(allocated * sizeof(nkGridTrack_t));
+
+    if (newTracks == NULL)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < allocated; i++)
+    {
+        newTracks[i] = defined ? definitions[i] : nkGridTrack_Star(1.0f);
+
+        /* forces the first arrange to solve */
+        newTracks[i].content = 0.0f;
+        newTracks[i].solvedContent = NAN;
+        newTracks[i].size = 0.0f;
+        newTracks[i].offset = 0.0f;
+    }
+
+    free(*tracks);
+
+    *tracks = newTracks;
+    *trackCount = allocated;
+
+    return true;
+}
+
+/* clears content and builds the fixed prefix and last-flexible index used
+   to constrain children */
+static void PrepareTracks(nkGridTrack_t *tracks, size_t count)
+{
+    float fixedEnd = 0.0f;
+    size_t lastFlexible = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (tracks[i].type == GRID_TRACK_FIXED)
+        {
+            fixedEnd += tracks[i].value;
+        }
+        else
+        {
+            lastFlexible = i + 1;
+        }
+
+        tracks[i].content = 0.0f;
+        tracks[i].measureEnd = fixedEnd;
+        tracks[i].lastFlexible = lastFlexible;
+    }
+}
+
+/* the fixed size of a span, or INFINITY if any of it can grow */
+static float SpanAvailable(const nkGridTrack_t *tracks, size_t first, size_t last)
+{
+    if (tracks[last].lastFlexible > first)
+    {
+        return INFINITY;
+    }
+
+    return tracks[last].measureEnd - ((first > 0) ? tracks[first - 1].measureEnd : 0.0f);
+}
+
+/* grows the last flexible track of a span so the span covers the request */
+static void FitSpan(nkGridTrack_t *tracks, size_t first, size_t last, float request)
+{
+    if (tracks[last].lastFlexible <= first)
+    {
+        return; /* all fixed */
+    }
+
+    size_t target = tracks[last].lastFlexible - 1;
+
+    float spanStart = (first > 0) ? tracks[first - 1].measureEnd : 0.0f;
+    float deficit = request - (tracks[last].measureEnd - spanStart);
+
+    if (deficit > 0.0f)
+    {
+        float targetStart = (target > 0) ? tracks[target - 1].measureEnd : 0.0f;
+        float targetExtent = tracks[target].measureEnd - targetStart;
+
+        tracks[target].content = fmaxf(tracks[target].content, targetExtent + deficit);
+    }
+}
+
+/* sums fixed sizes and contents, storing the running total in measureEnd */
+static float TracksTotal(nkGridTrack_t *tracks, size_t count)
+{
+    float total = 0.0f;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        total += (tracks[i].type == GRID_TRACK_FIXED) ? tracks[i].value : tracks[i].content;
+        tracks[i].measureEnd = total;
+    }
+
+    return total;
+}
+
+/* fixed and auto tracks take their size, star tracks share what is left */
+static void SolveTracks(nkGridTrack_t *tracks, size_t count, float length)
+{
+    float used = 0.0f;
+    float weight = 0.0f;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        nkGridTrack_t *track = &tracks[i];
+
+        track->solvedContent = track->content;
+
+        switch (track->type)
+        {
+            case GRID_TRACK_FIXED:
+            {
+                track->size = track->value;
+            } break;
+
+            case GRID_TRACK_AUTO:
+            {
+                track->size = track->content;
+            } break;
+
+            default:
+            {
+                track->size = 0.0f;
+                weight += fmaxf(0.0f, track->value);
+            } break;
+        }
+
+        used += track->size;
+    }
+
+    float remaining = fmaxf(0.0f, length - used);
+    float offset = 0.0f;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        nkGridTrack_t *track = &tracks[i];
+
+        if (track->type == GRID_TRACK_STAR && weight > 0.0f)
+        {
+            track->size = remaining * fmaxf(0.0f, track->value) / weight;
+        }
+
+        track->offset = offset;
+        offset += track->size;
+    }
+}
+
+/* clamps a location and span to the defined tracks */
+static void GetSpan(size_t index, size_t span, size_t count, size_t *first, size_t *last)
+{
+    *first = (index < count) ? index : count - 1;
+
+    if (span <= 1)
+    {
+        *last = *first;
+    }
+    else
+    {
+        *last = (span - 1 < count - *first) ? *first + span - 1 : count - 1;
+    }
+}
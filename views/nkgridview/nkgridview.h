@@ -0,0 +1,82 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkgridview.h
+** Module       :  views
+** Author       :  SH
+** Created      :  2025-09-08 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Grid View header file
+**
+***************************************************************/
+
+#ifndef NKGRIDVIEW_H
+#define NKGRIDVIEW_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <nanoview.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef enum
+{
+    GRID_TRACK_FIXED,   /* value pixels */
+    GRID_TRACK_AUTO,    /* sized to its children */
+    GRID_TRACK_STAR     /* shares the leftover space, value is the weight */
+} nkGridTrackType_t;
+
+typedef struct
+{
+    nkGridTrackType_t type;
+    float value;
+
+    /* solved by the grid */
+    float content;          /* largest request placed in the track */
+    float solvedContent;    /* content the current sizes were solved from */
+    float measureEnd;       /* running extent up to and including this track, while measuring */
+    size_t lastFlexible;    /* 1 + index of the last auto/star track up to here, 0 if none */
+    float size;
+    float offset;           /* from the grid's origin */
+} nkGridTrack_t;
+
+typedef struct
+{
+    nkView_t view;          /* view */
+
+    nkGridTrack_t *rows;    /* owned, set with nkGridView_SetRows */
+    size_t rowCount;
+    nkGridTrack_t *columns; /* owned, set with nkGridView_SetColumns */
+    size_t columnCount;
+
+    nkSize_t solvedSize;    /* frame size the track sizes were solved for */
+    bool tracksValid;
+} nkGridView_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+nkGridTrack_t nkGridTrack_Fixed(float size);
+nkGridTrack_t nkGridTrack_Auto(void);
+nkGridTrack_t nkGridTrack_Star(float weight);
+
+/* a grid starts with a single star row and column. Children pick their
+   cell with view.gridLocation; out of range rows and columns are clamped. */
+bool nkGridView_Create(nkGridView_t *gridView);
+
+void nkGridView_Destroy(nkGridView_t *gridView);
+
+bool nkGridView_SetRows(nkGridView_t *gridView, const nkGridTrack_t *rows, size_t count);
+bool nkGridView_SetColumns(nkGridView_t *gridView, const nkGridTrack_t *columns, size_t count);
+
+#endif /* NKGRIDVIEW_H */
@@ -33,12 +33,16 @@
 ** MARK: STATIC VARIABLES
 ***************************************************************/
 
+static nkStyle_t defaultStyle;
+static bool defaultStyleCreated = false;
+
 /***************************************************************
 ** MARK: STATIC FUNCTION DEFS
 ***************************************************************/
 
-static void DrawCallback(nkView_t *view, nkDrawContext_t *context);
-static void MeasureCallback(nkView_t *view, nkDrawContext_t *context);
+static void RecordCallback(nkView_t *view, nkDisplayList_t *list);
+static nkSize_t MeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context);
+static const nkStyle_t *CurrentStyle(const nkLabel_t *label);
 
 /***************************************************************
 ** MARK: PUBLIC FUNCTIONS
@@ -53,15 +57,14 @@ bool nkLabel_Create(nkLabel_t *label)
 
     /* Set default values */
     label->text = NULL;
+    label->style = NULL;
 
-    label->view.drawCallback = DrawCallback;
-    label->view.measureCallback = MeasureCallback;
+    label->view.recordCallback = RecordCallback;
+    label->view.measureSizeCallback = MeasureCallback;
 
     label->view.data = label;
     label->view.dataSize = sizeof(nkLabel_t);
 
-    label->foreground = NK_COLOR_BLACK; /* Default foreground color */
-    label->padding = nkThickness_FromConstant(0.0f);
     label->view.margin = nkThickness_FromConstant(0.0f);
 
 
@@ -73,11 +76,60 @@ void nkLabel_Destroy(nkLabel_t *label)
 
 }
 
+const nkStyle_t *nkLabel_DefaultStyle(void)
+{
+    if (!defaultStyleCreated)
+    {
+        nkStyle_Create(&defaultStyle, NULL, nkThickness_FromConstant(0.0f), 0.0f, NK_COLOR_BLACK, NK_COLOR_TRANSPARENT);
+        defaultStyleCreated = true;
+    }
+
+    return &defaultStyle;
+}
+
+void nkLabel_SetStyle(nkLabel_t *label, const nkStyle_t *style)
+{
+    if (label == NULL || style == label->style)
+    {
+        return;
+    }
+
+    const nkStyle_t *previous = CurrentStyle(label);
+
+    label->style = style;
+
+    if (nkStyle_ChangesMetrics(previous, CurrentStyle(label)))
+    {
+        nkView_InvalidateMeasure(&label->view);
+    }
+
+    nkView_InvalidateVisual(&label->view);
+}
+
+void nkLabel_SetText(nkLabel_t *label, const char *text)
+{
+    if (label == NULL)
+    {
+        return;
+    }
+
+    /* another copy of the same string */
+    if (text != label->text && text != NULL && label->text != NULL && strcmp(text, label->text) == 0)
+    {
+        label->text = text;
+        return;
+    }
+
+    label->text = text;
+    nkView_InvalidateMeasure(&label->view);
+    nkView_InvalidateVisual(&label->view);
+}
+
 /***************************************************************
 ** MARK: STATIC FUNCTIONS
 ***************************************************************/
 
-static void DrawCallback(nkView_t *view, nkDrawContext_t *context)
+static void RecordCallback(nkView_t *view, nkDisplayList_t *list)
 {
     nkLabel_t *label = (nkLabel_t *)view->data;
 
@@ -86,34 +138,51 @@ static void DrawCallback(nkView_t *view, nkDrawContext_t *context)
         return;
     }
 
-    if (label->background.a > 0.001f)
-    {
-        nkColor_t bgColor = label->background;
+    const nkStyle_t *style = CurrentStyle(label);
 
-        nkDraw_SetColor(context, bgColor);
-        nkDraw_Rect(context, view->frame.x, view->frame.y, view->frame.width, view->frame.height);
+    if (style->background.a > 0.001f)
+    {
+        nkDisplayList_SetColor(list, style->background);
+        nkDisplayList_Rect(list, view->frame.x, view->frame.y, view->frame.width, view->frame.height);
     }
 
     if (label->text)
     {
-        nkDraw_SetColor(context, label->foreground);
-        nkDraw_Text(context, label->font, label->text, view->frame.x + label->padding.left, view->frame.y + 12.0f + label->padding.top);
+        nkDisplayList_SetColor(list, style->foreground);
+        nkDisplayList_Text(list, style->font, label->text, view->frame.x + style->padding.left, view->frame.y + 12.0f + style->padding.top);
     }
 
 }
 
-static void MeasureCallback(nkView_t *view, nkDrawContext_t *context)
+static nkSize_t MeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context)
 {
     nkLabel_t *label = (nkLabel_t *)view->data;
 
     if (label == NULL)
     {
-        return;
+        return view->sizeRequest;
     }
 
-    nkRect_t textFrame = nkDraw_MeasureText(context, label->font, label->text ? label->text : "");
+    const nkStyle_t *style = CurrentStyle(label);
+
+    /* labels don't wrap, so the desired size is independent of available */
+    nkRect_t textFrame = nkView_MeasureText(context, style->font, label->text ? label->text : "");
+
+    return (nkSize_t){
+        textFrame.width + style->padding.left + style->padding.right,
+        textFrame.height + style->padding.top + style->padding.bottom
+    };
+}
+
+/* its own style, else the theme's, else the default */
+static const nkStyle_t *CurrentStyle(const nkLabel_t *label)
+{
+    const nkTheme_t *theme = nkTheme_Current();
 
-    view->sizeRequest.width = textFrame.width + label->padding.left + label->padding.right;
-    view->sizeRequest.height = textFrame.height + label->padding.top + label->padding.bottom;
+    if (label->style != NULL)
+    {
+        return label->style;
+    }
 
+    return (theme != NULL && theme->label != NULL) ? theme->label : nkLabel_DefaultStyle();
 }
\ No newline at end of file
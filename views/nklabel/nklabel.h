@@ -20,6 +20,8 @@
 
 #include <nanoview.h>
 
+#include <views/nkstyle/nkstyle.h>
+
 /***************************************************************
 ** MARK: CONSTANTS & MACROS
 ***************************************************************/
@@ -32,14 +34,9 @@ typedef struct
 {
     nkView_t view;          /* view */
 
-    nkThickness_t padding;  /* padding around the button contents */
-
-    const char *text;       /* button text */
-    nkFont_t *font;         /* button font */
-    nkColor_t foreground; 
+    const char *text;       /* label text, see nkLabel_SetText */
+    const nkStyle_t *style; /* font, padding and colours, shared, or NULL to follow the theme; see nkLabel_SetStyle */
 
-    nkColor_t background;   /* button background color */
-    
 } nkLabel_t;
 
 /***************************************************************
@@ -50,4 +47,16 @@ bool nkLabel_Create(nkLabel_t *label);
 
 void nkLabel_Destroy(nkLabel_t *label);
 
+/* the style labels follow when the theme (see nkTheme_Set) sets none */
+const nkStyle_t *nkLabel_DefaultStyle(void);
+
+/* swaps the style, NULL to follow the theme again, measuring again only if
+   the font or padding differ */
+void nkLabel_SetStyle(nkLabel_t *label, const nkStyle_t *style);
+
+/* Sets the text, which isn't copied, and measures again. Changing the
+   characters text points to in place needs nkLabel_SetText with the same
+   pointer, or nkView_InvalidateMeasure, to be seen. */
+void nkLabel_SetText(nkLabel_t *label, const char *text);
+
 #endif /* NKLABEL_H */
\ No newline at end of file
@@ -38,7 +38,9 @@
 ** MARK: STATIC FUNCTION DEFS
 ***************************************************************/
 
-static void DrawCallback(nkView_t *view, nkDrawContext_t *context);
+static void RecordCallback(nkView_t *view, nkDisplayList_t *list);
+
+static nkSize_t MeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context);
 
 static void ArrangeCallback(nkView_t *view, nkDrawContext_t *context);
 
@@ -50,6 +52,10 @@ static void PointerMovementCallback(nkView_t *view, float x, float y);
 
 static void PointerActionCallback(nkView_t *view, nkPointerAction_t action, nkPointerEvent_t event, float x, float y);
 
+static void ApplyScrollOffset(nkScrollView_t *scrollView);
+
+static uint32_t VisualState(nkScrollView_t *scrollView);
+
 
 /***************************************************************
 ** MARK: PUBLIC FUNCTIONS
@@ -62,9 +68,10 @@ bool nkScrollView_Create(nkScrollView_t *scrollView)
         return false;
     }
 
-    scrollView->view.measureCallback = NULL; /* No measure callback for scrollviewer */
+    scrollView->view.measureSizeCallback = MeasureCallback;
     scrollView->view.arrangeCallback = ArrangeCallback;
-    scrollView->view.drawCallback = DrawCallback;
+    scrollView->view.measureThreadSafe = true; /* measures its content, a subtree only this task reaches */
+    scrollView->view.recordCallback = RecordCallback;
 
     scrollView->view.pointerHoverCallback = HoverCallback;
     scrollView->view.capturePointerHover = true; /* Enable pointer hover capture */
@@ -99,7 +106,6 @@ bool nkScrollView_Create(nkScrollView_t *scrollView)
 
     scrollView->dragOrigin = (nkPoint_t){0, 0};
 
-    scrollView->needsLayout = false; /* Initially needs layout */
     scrollView->view.clipToBounds = true; /* Clip to bounds by default */
 
     return true;
@@ -115,6 +121,18 @@ void nkScrollView_Destroy(nkScrollView_t *scrollView)
 ** MARK: STATIC FUNCTIONS
 ***************************************************************/
 
+static nkSize_t MeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context)
+{
+    /* content may be as large as it likes, the scroll view itself keeps
+       whatever size was requested for it */
+    if (view->child)
+    {
+        nkView_Measure(view->child, (nkSize_t){INFINITY, INFINITY}, context);
+    }
+
+    return view->sizeRequest;
+}
+
 static void ArrangeCallback(nkView_t *view, nkDrawContext_t *context)
 {
 
@@ -137,8 +155,7 @@ static void ArrangeCallback(nkView_t *view, nkDrawContext_t *context)
         marginRequest.width += child->margin.left + child->margin.right;
         marginRequest.height += child->margin.top + child->margin.bottom;
 
-        childRect.x = client.x - scrollView->horizontalScrollOffset * (marginRequest.width);
-        childRect.y = client.y - scrollView->verticalScrollOffset * (marginRequest.height);
+        /* placed unscrolled, the offset is applied when drawing */
         childRect.width = marginRequest.width;
         childRect.height = marginRequest.height;
 
@@ -147,41 +164,11 @@ static void ArrangeCallback(nkView_t *view, nkDrawContext_t *context)
         scrollView->verticalScrollRatio = view->child->frame.height / view->frame.height;
         scrollView->horizontalScrollRatio = view->child->frame.width / view->frame.width;
 
-        /* clip scroll offset to max value */
-        scrollView->verticalScrollOffset = fmaxf(0.0f, fminf(1.0f - (1.0f / scrollView->verticalScrollRatio), scrollView->verticalScrollOffset));
-        scrollView->horizontalScrollOffset = fmaxf(0.0f, fminf(1.0f - (1.0f / scrollView->horizontalScrollRatio), scrollView->horizontalScrollOffset));
-
-        if (scrollView->verticalScrollRatio > 1.0f)
-        {
-            float barHeight = view->frame.height * (1.0f / scrollView->verticalScrollRatio);
-            float maxOffset = 1.0f - (1.0f / scrollView->verticalScrollRatio);
-
-            scrollView->verticalScrollBar = (nkRect_t) {
-                .x = view->frame.x + view->frame.width - 10.0f,
-                .y = view->frame.y + ((scrollView->verticalScrollOffset / maxOffset) * (view->frame.height - barHeight)),
-                .width = 10.0f,
-                .height = barHeight
-            };
-
-        }
-
-        if (scrollView->horizontalScrollRatio > 1.0f)
-        {
-
-            float barWidth = view->frame.width * (1.0f / scrollView->horizontalScrollRatio);
-            float maxOffset = 1.0f - (1.0f / scrollView->horizontalScrollRatio);
-
-            scrollView->horizontalScrollBar = (nkRect_t) {
-                .x = view->frame.x + ((scrollView->horizontalScrollOffset / maxOffset) * (view->frame.width - barWidth)),
-                .y = view->frame.y + view->frame.height - 10.0f,
-                .width = barWidth,
-                .height = 10.0f
-            };
-        }
+        ApplyScrollOffset(scrollView);
     }
 }
 
-static void DrawCallback(nkView_t *view, nkDrawContext_t *context)
+static void RecordCallback(nkView_t *view, nkDisplayList_t *list)
 {
     
     nkScrollView_t *scrollView = (nkScrollView_t *)view->data;
@@ -191,12 +178,6 @@ static void DrawCallback(nkView_t *view, nkDrawContext_t *context)
         return;
     }
 
-    if (scrollView->needsLayout)
-    {
-        nkView_LayoutSubtree(view, context);
-        scrollView->needsLayout = false; /* Reset layout flag */
-    }
-
     if (!view->child)
     {
         return;
@@ -209,15 +190,15 @@ static void DrawCallback(nkView_t *view, nkDrawContext_t *context)
          
         if (scrollView->isVerticalScrollHighlighted)
         {
-            nkDraw_SetColor(context, nkColor_Lighten(NK_COLOR_DARK_GRAY, 0.25f));
+            nkDisplayList_SetColor(list, nkColor_Lighten(NK_COLOR_DARK_GRAY, 0.25f));
         } 
         else
         {
-            nkDraw_SetColor(context, NK_COLOR_DARK_GRAY);
+            nkDisplayList_SetColor(list, NK_COLOR_DARK_GRAY);
         }
 
-        nkDraw_Rect(
-            context, 
+        nkDisplayList_Rect(
+            list, 
             scrollView->verticalScrollBar.x, scrollView->verticalScrollBar.y, 
             scrollView->verticalScrollBar.width, scrollView->verticalScrollBar.height
         );
@@ -229,15 +210,15 @@ static void DrawCallback(nkView_t *view, nkDrawContext_t *context)
 
         if (scrollView->isHorizontalScrollHighlighted)
         {
-            nkDraw_SetColor(context, nkColor_Lighten(NK_COLOR_DARK_GRAY, 0.25f));
+            nkDisplayList_SetColor(list, nkColor_Lighten(NK_COLOR_DARK_GRAY, 0.25f));
         } 
         else
         {
-            nkDraw_SetColor(context, NK_COLOR_DARK_GRAY);
+            nkDisplayList_SetColor(list, NK_COLOR_DARK_GRAY);
         }
 
-        nkDraw_Rect(
-            context, 
+        nkDisplayList_Rect(
+            list, 
             scrollView->horizontalScrollBar.x, scrollView->horizontalScrollBar.y, 
             scrollView->horizontalScrollBar.width, scrollView->horizontalScrollBar.height
         );
@@ -254,22 +235,25 @@ static void ScrollCallback(nkView_t *view, float delta)
     {
         return;
     }
+
+    uint32_t previousState = VisualState(scrollView);
     
     if (scrollView->verticalScrollRatio > 1.0f)
     {
         scrollView->verticalScrollOffset -= (delta * 30.0f) / view->child->frame.height;
 
-        scrollView->verticalScrollOffset = fmaxf(0.0f, fminf(1.0f - (1.0f / scrollView->verticalScrollRatio), scrollView->verticalScrollOffset));
-        
-        scrollView->needsLayout = true; /* Mark layout as needing update */
+        ApplyScrollOffset(scrollView);
     }
     else if (scrollView->horizontalScrollRatio > 1.0f)
     {
         scrollView->horizontalScrollOffset -= (delta * 30.0f) / view->child->frame.width;
 
-        scrollView->horizontalScrollOffset = fmaxf(0.0f, fminf(1.0f - (1.0f / scrollView->horizontalScrollRatio), scrollView->horizontalScrollOffset));
+        ApplyScrollOffset(scrollView);
+    }
 
-        scrollView->needsLayout = true; /* Mark layout as needing update */
+    if (VisualState(scrollView) != previousState)
+    {
+        nkView_InvalidateVisual(view);
     }
 }
 
@@ -282,11 +266,18 @@ static void HoverCallback(nkView_t *view, nkPointerHover_t hover)
         return;
     }
 
+    uint32_t previousState = VisualState(scrollView);
+
     if (hover == HOVER_END)
     {
         scrollView->isVerticalScrollHighlighted = false;
         scrollView->isHorizontalScrollHighlighted = false;
     }
+
+    if (VisualState(scrollView) != previousState)
+    {
+        nkView_InvalidateVisual(view);
+    }
 }
 
 static void PointerMovementCallback(nkView_t *view, float x, float y)
@@ -298,6 +289,8 @@ static void PointerMovementCallback(nkView_t *view, float x, float y)
         return;
     }
 
+    uint32_t previousState = VisualState(scrollView);
+
     if (nkRect_ContainsPoint(scrollView->verticalScrollBar, (nkPoint_t){x, y}))
     {
         scrollView->isVerticalScrollHighlighted = true;
@@ -311,6 +304,11 @@ static void PointerMovementCallback(nkView_t *view, float x, float y)
         scrollView->isVerticalScrollHighlighted = false;
         scrollView->isHorizontalScrollHighlighted = false;
     }
+
+    if (VisualState(scrollView) != previousState)
+    {
+        nkView_InvalidateVisual(view);
+    }
 }   
 
 static void PointerActionCallback(nkView_t *view, nkPointerAction_t action, nkPointerEvent_t event, float x, float y)
@@ -322,6 +320,8 @@ static void PointerActionCallback(nkView_t *view, nkPointerAction_t action, nkPo
         return;
     }
 
+    uint32_t previousState = VisualState(scrollView);
+
     switch (event)
     {
         case POINTER_EVENT_BEGIN:
@@ -354,9 +354,7 @@ static void PointerActionCallback(nkView_t *view, nkPointerAction_t action, nkPo
                 float deltaY = y - scrollView->dragOrigin.y;
                 scrollView->verticalScrollOffset = scrollView->dragStartOffset.y + deltaY / view->child->frame.height * scrollView->verticalScrollRatio;
 
-                scrollView->verticalScrollOffset = fmaxf(0.0f, fminf(1.0f - (1.0f / scrollView->verticalScrollRatio), scrollView->verticalScrollOffset));
-
-                scrollView->needsLayout = true; /* Mark layout as needing update */
+                ApplyScrollOffset(scrollView);
             }
 
             if (scrollView->isHorizontalScrollPressed)
@@ -364,9 +362,7 @@ static void PointerActionCallback(nkView_t *view, nkPointerAction_t action, nkPo
                 float deltaX = x - scrollView->dragOrigin.x;
                 scrollView->horizontalScrollOffset = scrollView->dragStartOffset.x + deltaX / view->child->frame.width * scrollView->horizontalScrollRatio;
 
-                scrollView->horizontalScrollOffset = fmaxf(0.0f, fminf(1.0f - (1.0f / scrollView->horizontalScrollRatio), scrollView->horizontalScrollOffset));
-                
-                scrollView->needsLayout = true; /* Mark layout as needing update */
+                ApplyScrollOffset(scrollView);
             }
         } break;
 
@@ -376,4 +372,80 @@ static void PointerActionCallback(nkView_t *view, nkPointerAction_t action, nkPo
         } break;
     }
 
-}
\ No newline at end of file
+    if (VisualState(scrollView) != previousState)
+    {
+        nkView_InvalidateVisual(view);
+    }
+}
+
+/* clamps the scroll offsets, moves the scroll bars to match and shifts the
+   content by them, leaving its layout alone */
+static void ApplyScrollOffset(nkScrollView_t *scrollView)
+{
+    nkView_t *view = &scrollView->view;
+    nkView_t *child = view->child;
+
+    if (child == NULL)
+    {
+        return;
+    }
+
+    nkRect_t verticalScrollBar = scrollView->verticalScrollBar;
+    nkRect_t horizontalScrollBar = scrollView->horizontalScrollBar;
+
+    /* clip scroll offset to max value */
+    scrollView->verticalScrollOffset = fmaxf(0.0f, fminf(1.0f - (1.0f / scrollView->verticalScrollRatio), scrollView->verticalScrollOffset));
+    scrollView->horizontalScrollOffset = fmaxf(0.0f, fminf(1.0f - (1.0f / scrollView->horizontalScrollRatio), scrollView->horizontalScrollOffset));
+
+    if (scrollView->verticalScrollRatio > 1.0f)
+    {
+        float barHeight = view->frame.height * (1.0f / scrollView->verticalScrollRatio);
+        float maxOffset = 1.0f - (1.0f / scrollView->verticalScrollRatio);
+
+        scrollView->verticalScrollBar = (nkRect_t) {
+            .x = view->frame.x + view->frame.width - 10.0f,
+            .y = view->frame.y + ((scrollView->verticalScrollOffset / maxOffset) * (view->frame.height - barHeight)),
+            .width = 10.0f,
+            .height = barHeight
+        };
+
+    }
+
+    if (scrollView->horizontalScrollRatio > 1.0f)
+    {
+
+        float barWidth = view->frame.width * (1.0f / scrollView->horizontalScrollRatio);
+        float maxOffset = 1.0f - (1.0f / scrollView->horizontalScrollRatio);
+
+        scrollView->horizontalScrollBar = (nkRect_t) {
+            .x = view->frame.x + ((scrollView->horizontalScrollOffset / maxOffset) * (view->frame.width - barWidth)),
+            .y = view->frame.y + view->frame.height - 10.0f,
+            .width = barWidth,
+            .height = 10.0f
+        };
+    }
+
+    if (memcmp(&verticalScrollBar, &scrollView->verticalScrollBar, sizeof(nkRect_t)) != 0 ||
+        memcmp(&horizontalScrollBar, &scrollView->horizontalScrollBar, sizeof(nkRect_t)) != 0)
+    {
+        nkView_InvalidateVisual(view);
+    }
+
+    nkSize_t marginRequest = child->sizeRequest;
+    marginRequest.width += child->margin.left + child->margin.right;
+    marginRequest.height += child->margin.top + child->margin.bottom;
+
+    nkView_SetChildOffset(view, (nkPoint_t){
+        -scrollView->horizontalScrollOffset * marginRequest.width,
+        -scrollView->verticalScrollOffset * marginRequest.height
+    });
+}
+
+/* the state drawing depends on besides the frame, packed for comparison */
+static uint32_t VisualState(nkScrollView_t *scrollView)
+{
+    return (uint32_t)scrollView->isVerticalScrollHighlighted |
+        (uint32_t)scrollView->isVerticalScrollPressed << 1 |
+        (uint32_t)scrollView->isHorizontalScrollHighlighted << 2 |
+        (uint32_t)scrollView->isHorizontalScrollPressed << 3;
+}
@@ -32,8 +32,6 @@ typedef struct
 {
     nkView_t view;          /* view */
 
-    bool needsLayout; /* true if layout needs to be recalculated */
-
     float verticalScrollRatio; 
     float verticalScrollLimit;
     float verticalScrollOffset;
@@ -38,7 +38,7 @@
 ** MARK: STATIC FUNCTION DEFS
 ***************************************************************/
 
-static void MeasureCallback(nkView_t *view, nkDrawContext_t *context);
+static nkSize_t MeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context);
 static void ArrangeCallback(nkView_t *view, nkDrawContext_t *context);
 
 /***************************************************************
@@ -52,8 +52,9 @@ bool nkStackView_Create(nkStackView_t *stackView)
         return false;
     }
 
-    stackView->view.measureCallback = MeasureCallback;
+    stackView->view.measureSizeCallback = MeasureCallback;
     stackView->view.arrangeCallback = ArrangeCallback;
+    stackView->view.measureThreadSafe = true; /* measure writes only into this subtree, which no concurrent task shares */
 
     /* Set default values */
     stackView->orientation = STACK_ORIENTATION_HORIZONTAL;
@@ -74,14 +75,14 @@ void nkStackView_Destroy(nkStackView_t *stackView)
 ** MARK: STATIC FUNCTIONS
 ***************************************************************/
 
-static void MeasureCallback(nkView_t *view, nkDrawContext_t *context)
+static nkSize_t MeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context)
 {
 
     nkStackView_t *stackView = (nkStackView_t *)view->data;
 
     if (!stackView || view->dataSize != sizeof(nkStackView_t))
     {
-        return;
+        return view->sizeRequest;
     }
 
     nkSize_t total = {0, 0};
@@ -90,7 +91,22 @@ static void MeasureCallback(nkView_t *view, nkDrawContext_t *context)
     while (child)
     {
 
-        nkSize_t marginRequest = child->sizeRequest;
+        /* children are unconstrained along the stacking axis */
+        nkSize_t childAvailable = {
+            fmaxf(0.0f, available.width - child->margin.left - child->margin.right),
+            fmaxf(0.0f, available.height - child->margin.top - child->margin.bottom)
+        };
+
+        if (stackView->orientation == STACK_ORIENTATION_VERTICAL)
+        {
+            childAvailable.height = INFINITY;
+        }
+        else
+        {
+            childAvailable.width = INFINITY;
+        }
+
+        nkSize_t marginRequest = nkView_Measure(child, childAvailable, context);
         marginRequest.width += child->margin.left + child->margin.right;
         marginRequest.height += child->margin.top + child->margin.bottom;
 
@@ -112,7 +128,7 @@ static void MeasureCallback(nkView_t *view, nkDrawContext_t *context)
         child = child->sibling;
     }
 
-    view->sizeRequest = total;
+    return total;
 }
 
 static void ArrangeCallback(nkView_t *view, nkDrawContext_t *context)
@@ -0,0 +1,150 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkstyle.c
+** Module       :  views
+** Author       :  SH
+** Created      :  2025-09-23 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Shared control styles: fonts, padding and the
+**                 colours of each visual state, derived once
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkstyle.h"
+
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static const nkTheme_t *currentTheme = NULL;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static nkStyleColors_t DeriveColors(nkColor_t background, bool highlighted, bool pressed);
+static bool ThemeChangesMetrics(const nkTheme_t *a, const nkTheme_t *b);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkStyle_Create(nkStyle_t *style, nkFont_t *font, nkThickness_t padding, float cornerRadius, nkColor_t foreground, nkColor_t background)
+{
+    style->font = font;
+    style->padding = padding;
+    style->cornerRadius = cornerRadius;
+
+    style->foreground = foreground;
+    style->background = background;
+
+    for (int state = 0; state < STYLE_STATE_COUNT; state++)
+    {
+        style->states[state] = DeriveColors(background, (state & STYLE_STATE_HIGHLIGHTED) != 0, (state & STYLE_STATE_PRESSED) != 0);
+    }
+}
+
+nkStyleState_t nkStyle_State(bool highlighted, bool pressed)
+{
+    return (nkStyleState_t)((highlighted ? STYLE_STATE_HIGHLIGHTED : 0) | (pressed ? STYLE_STATE_PRESSED : 0));
+}
+
+bool nkStyle_ChangesMetrics(const nkStyle_t *a, const nkStyle_t *b)
+{
+    if (a == b)
+    {
+        return false;
+    }
+
+    if (a == NULL || b == NULL)
+    {
+        return true;
+    }
+
+    return a->font != b->font || memcmp(&a->padding, &b->padding, sizeof(nkThickness_t)) != 0;
+}
+
+void nkTheme_Set(const nkTheme_t *theme, nkView_t *root)
+{
+    if (theme == currentTheme)
+    {
+        return;
+    }
+
+    bool metrics = ThemeChangesMetrics(currentTheme, theme);
+
+    currentTheme = theme;
+
+    /* which views follow the theme isn't known here, so all of them repaint */
+    nkViewIterator_t iterator;
+
+    for (nkView_t *view = nkView_PreOrderBegin(&iterator, root); view; view = nkView_PreOrderNext(&iterator))
+    {
+        if (metrics)
+        {
+            nkView_InvalidateMeasure(view);
+        }
+
+        nkView_InvalidateVisual(view);
+    }
+}
+
+const nkTheme_t *nkTheme_Current(void)
+{
+    return currentTheme;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+/* highlight lightens the whole control, pressing flips the bevel */
+static nkStyleColors_t DeriveColors(nkColor_t background, bool highlighted, bool pressed)
+{
+    nkColor_t base = highlighted ? nkColor_Lighten(background, 0.5f) : background;
+    nkStyleColors_t colors;
+
+    colors.fillStart = nkColor_Lighten(base, 0.5f);
+    colors.fillEnd = base;
+
+    if (pressed)
+    {
+        colors.borderStart = nkColor_Darken(base, 0.0625f);
+        colors.borderEnd = nkColor_Lighten(base, 0.75f);
+    }
+    else
+    {
+        colors.borderStart = nkColor_Lighten(base, 0.75f);
+        colors.borderEnd = nkColor_Darken(base, 0.125f);
+    }
+
+    return colors;
+}
+
+/* a kind left on its default counts as differing from any style, as the
+   default isn't known here */
+static bool ThemeChangesMetrics(const nkTheme_t *a, const nkTheme_t *b)
+{
+    const nkTheme_t none = {NULL, NULL};
+
+    a = (a != NULL) ? a : &none;
+    b = (b != NULL) ? b : &none;
+
+    return nkStyle_ChangesMetrics(a->button, b->button) || nkStyle_ChangesMetrics(a->label, b->label);
+}
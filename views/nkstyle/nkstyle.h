@@ -0,0 +1,94 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkstyle.h
+** Module       :  views
+** Author       :  SH
+** Created      :  2025-09-23 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Shared control styles: fonts, padding and the
+**                 colours of each visual state, derived once, and
+**                 the theme controls without their own style follow
+**
+***************************************************************/
+
+#ifndef NKSTYLE_H
+#define NKSTYLE_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <nanoview.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* index into nkStyle_t.states, see nkStyle_State */
+typedef enum
+{
+    STYLE_STATE_NORMAL = 0,
+    STYLE_STATE_HIGHLIGHTED = 1,
+    STYLE_STATE_PRESSED = 2,
+    STYLE_STATE_HIGHLIGHTED_PRESSED = 3,
+    STYLE_STATE_COUNT
+} nkStyleState_t;
+
+/* the colours a control draws with in one visual state */
+typedef struct
+{
+    nkColor_t fillStart;    /* background gradient */
+    nkColor_t fillEnd;
+    nkColor_t borderStart;  /* border gradient */
+    nkColor_t borderEnd;
+} nkStyleColors_t;
+
+/* Immutable once created: controls only keep a pointer to it, so any number
+   of them can share one. Restyling one control is nkXxx_SetStyle, and every
+   control following the theme is nkTheme_Set. */
+typedef struct
+{
+    nkFont_t *font;
+    nkThickness_t padding;  /* around the control's contents */
+    float cornerRadius;
+
+    nkColor_t foreground;   /* text */
+    nkColor_t background;   /* base colour the states are derived from */
+
+    nkStyleColors_t states[STYLE_STATE_COUNT];
+} nkStyle_t;
+
+/* the style each kind of control takes when it has none of its own; NULL
+   leaves that kind on its default style */
+typedef struct
+{
+    const nkStyle_t *button;
+    const nkStyle_t *label;
+} nkTheme_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+void nkStyle_Create(nkStyle_t *style, nkFont_t *font, nkThickness_t padding, float cornerRadius, nkColor_t foreground, nkColor_t background);
+
+nkStyleState_t nkStyle_State(bool highlighted, bool pressed);
+
+/* true if controls must be measured again after switching from a to b */
+bool nkStyle_ChangesMetrics(const nkStyle_t *a, const nkStyle_t *b);
+
+/* Switches every control without its own style to theme, NULL for the
+   defaults. Controls read the theme when they draw and measure, so this is
+   one pointer store; the views under root are then invalidated (their
+   measure too if a font or padding may change) so the next frame shows it.
+   theme is not copied and must outlive its use. */
+void nkTheme_Set(const nkTheme_t *theme, nkView_t *root);
+const nkTheme_t *nkTheme_Current(void);
+
+#endif /* NKSTYLE_H */
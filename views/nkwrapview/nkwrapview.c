@@ -0,0 +1,937 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nkwrapview.c
+** Module       :  views
+** Author       :  SH
+** Created      :  2025-09-11 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Wrap View
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nkwrapview.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static nkSize_t MeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context);
+static void ArrangeCallback(nkView_t *view, nkDrawContext_t *context);
+static size_t QueryChildrenCallback(nkView_t *view, nkRect_t region, nkView_t *const **children);
+static void ChildChangedCallback(nkView_t *view, nkView_t *child);
+static void ChildListCallback(nkView_t *view, nkView_t *child, bool added);
+static size_t EditedIndexOf(nkWrapView_t *wrapView, nkView_t *child);
+
+static bool IndexCurrent(nkWrapView_t *wrapView);
+static bool SyncChildren(nkWrapView_t *wrapView);
+static bool ReplayEdits(nkWrapView_t *wrapView, size_t *first, size_t *kept);
+static size_t IndexOf(nkWrapView_t *wrapView, nkView_t *child);
+static bool Reflow(nkWrapView_t *wrapView, float length, nkDrawContext_t *context);
+static void PlaceLines(nkWrapView_t *wrapView, size_t first, size_t last);
+static size_t FindLines(nkWrapView_t *wrapView, nkRect_t region, size_t *first);
+static size_t LineAt(nkWrapView_t *wrapView, size_t index);
+static bool LinesCurrent(nkWrapView_t *wrapView);
+static float MainOf(nkWrapView_t *wrapView, nkSize_t size);
+static float CrossOf(nkWrapView_t *wrapView, nkSize_t size);
+static bool ReserveChildren(nkWrapView_t *wrapView, size_t needed);
+static bool ReserveLines(nkWrapView_t *wrapView, size_t needed);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool nkWrapView_Create(nkWrapView_t *wrapView)
+{
+    if (!nkView_Create(&wrapView->view, "WrapView"))
+    {
+        return false;
+    }
+
+    wrapView->view.measureSizeCallback = MeasureCallback;
+    wrapView->view.arrangeCallback = ArrangeCallback;
+    wrapView->view.queryChildrenCallback = QueryChildrenCallback;
+    wrapView->view.childChangedCallback = ChildChangedCallback;
+    wrapView->view.childListCallback = ChildListCallback;
+    wrapView->view.measureThreadSafe = true; /* reflow measures children and rewrites the lines, both owned by this subtree alone */
+
+    /* Set default values */
+    wrapView->orientation = WRAP_ORIENTATION_HORIZONTAL;
+
+    wrapView->children = NULL;
+    wrapView->requests = NULL;
+    wrapView->childCount = 0;
+    wrapView->childCapacity = 0;
+
+    wrapView->lines = NULL;
+    wrapView->spareLines = NULL;
+    wrapView->lineCount = 0;
+    wrapView->lineCapacity = 0;
+
+    wrapView->flowLength = NAN;
+    wrapView->firstDirty = 0;
+    wrapView->lastDirty = SIZE_MAX;
+    wrapView->tailShift = 0;
+    wrapView->editCount = 0;
+    wrapView->placedFrame = (nkRect_t){NAN, NAN, NAN, NAN};
+    wrapView->placementVersion = 0;
+    wrapView->indexedStructureVersion = 0;
+    wrapView->indexValid = false;
+
+    wrapView->view.data = wrapView;
+    wrapView->view.dataSize = sizeof(nkWrapView_t);
+
+    return true;
+}
+
+void nkWrapView_Destroy(nkWrapView_t *wrapView)
+{
+    if (wrapView == NULL)
+    {
+        return;
+    }
+
+    free(wrapView->children);
+    free(wrapView->requests);
+    free(wrapView->lines);
+    free(wrapView->spareLines);
+
+    wrapView->children = NULL;
+    wrapView->requests = NULL;
+    wrapView->childCount = 0;
+    wrapView->childCapacity = 0;
+    wrapView->lines = NULL;
+    wrapView->spareLines = NULL;
+    wrapView->lineCount = 0;
+    wrapView->lineCapacity = 0;
+    wrapView->indexValid = false;
+}
+
+void nkWrapView_SetOrientation(nkWrapView_t *wrapView, nkWrapOrientation_t orientation)
+{
+    if (wrapView == NULL || wrapView->orientation == orientation)
+    {
+        return;
+    }
+
+    wrapView->orientation = orientation;
+
+    /* every request is re-read along the new axes */
+    wrapView->flowLength = NAN;
+    wrapView->firstDirty = 0;
+    wrapView->lastDirty = SIZE_MAX;
+    wrapView->placedFrame = (nkRect_t){NAN, NAN, NAN, NAN};
+
+    nkView_InvalidateMeasure(&wrapView->view);
+    nkView_InvalidateArrange(&wrapView->view);
+}
+
+size_t nkWrapView_LineOfChild(nkWrapView_t *wrapView, nkView_t *child)
+{
+    if (wrapView == NULL || child == NULL || child->parent != &wrapView->view || !LinesCurrent(wrapView))
+    {
+        return SIZE_MAX;
+    }
+
+    size_t index = IndexOf(wrapView, child);
+
+    return (index != SIZE_MAX) ? LineAt(wrapView, index) : SIZE_MAX;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static nkSize_t MeasureCallback(nkView_t *view, nkSize_t available, nkDrawContext_t *context)
+{
+
+    nkWrapView_t *wrapView = (nkWrapView_t *)view->data;
+
+    if (!wrapView || view->dataSize != sizeof(nkWrapView_t))
+    {
+        return view->sizeRequest;
+    }
+
+    if (!IndexCurrent(wrapView) && !SyncChildren(wrapView))
+    {
+        return view->sizeRequest;
+    }
+
+    float length = MainOf(wrapView, available);
+
+    if (length != wrapView->flowLength)
+    {
+        wrapView->firstDirty = 0;
+        wrapView->lastDirty = SIZE_MAX;
+    }
+
+    if (wrapView->firstDirty != SIZE_MAX && !Reflow(wrapView, length, context))
+    {
+        return view->sizeRequest;
+    }
+
+    float main = 0.0f;
+    float cross = 0.0f;
+
+    for (size_t i = 0; i < wrapView->lineCount; i++)
+    {
+        main = fmaxf(main, wrapView->lines[i].mainSize);
+    }
+
+    if (wrapView->lineCount > 0)
+    {
+        nkWrapLine_t *last = &wrapView->lines[wrapView->lineCount - 1];
+        cross = last->crossOffset + last->crossSize;
+    }
+
+    if (wrapView->orientation == WRAP_ORIENTATION_HORIZONTAL)
+    {
+        return (nkSize_t){main, cross};
+    }
+
+    return (nkSize_t){cross, main};
+}
+
+/* lines are flowed again if the frame's length differs from the measured
+   one. Only the visible lines are placed now, the rest as queries reach them. */
+static void ArrangeCallback(nkView_t *view, nkDrawContext_t *context)
+{
+
+    nkWrapView_t *wrapView = (nkWrapView_t *)view->data;
+
+    if (!wrapView || view->dataSize != sizeof(nkWrapView_t))
+    {
+        return;
+    }
+
+    nkRect_t frame = view->frame;
+
+    if (!IndexCurrent(wrapView) && !SyncChildren(wrapView))
+    {
+        return;
+    }
+
+    float length = MainOf(wrapView, (nkSize_t){frame.width, frame.height});
+
+    if (length != wrapView->flowLength)
+    {
+        wrapView->firstDirty = 0;
+        wrapView->lastDirty = SIZE_MAX;
+    }
+
+    if (wrapView->firstDirty != SIZE_MAX && !Reflow(wrapView, length, context))
+    {
+        return;
+    }
+
+    nkRect_t placed = wrapView->placedFrame;
+
+    if (placed.x != frame.x || placed.y != frame.y || placed.width != frame.width || placed.height != frame.height)
+    {
+        wrapView->placementVersion++;
+        wrapView->placedFrame = frame;
+    }
+
+    size_t first;
+    size_t last = FindLines(wrapView, nkView_VisibleChildRegion(view), &first);
+
+    PlaceLines(wrapView, first, last);
+}
+
+/* lines are sorted along the cross axis, so the visible children are one
+   run of the child array */
+static size_t QueryChildrenCallback(nkView_t *view, nkRect_t region, nkView_t *const **children)
+{
+    nkWrapView_t *wrapView = (nkWrapView_t *)view->data;
+
+    if (!wrapView || view->dataSize != sizeof(nkWrapView_t) || (!IndexCurrent(wrapView) && !SyncChildren(wrapView)))
+    {
+        *children = NULL;
+        return 0;
+    }
+
+    *children = wrapView->children;
+
+    if (!LinesCurrent(wrapView))
+    {
+        return wrapView->childCount;
+    }
+
+    size_t first;
+    size_t last = FindLines(wrapView, region, &first);
+
+    if (first == last)
+    {
+        return 0;
+    }
+
+    PlaceLines(wrapView, first, last);
+
+    nkWrapLine_t *lastLine = &wrapView->lines[last - 1];
+    *children = wrapView->children + wrapView->lines[first].first;
+
+    return lastLine->first + lastLine->count - wrapView->lines[first].first;
+}
+
+/* marks the child's request to be read again and widens the range to reflow */
+static void ChildChangedCallback(nkView_t *view, nkView_t *child)
+{
+    nkWrapView_t *wrapView = (nkWrapView_t *)view->data;
+
+    if (!wrapView || view->dataSize != sizeof(nkWrapView_t))
+    {
+        return;
+    }
+
+    size_t index = IndexOf(wrapView, child);
+
+    if (index == SIZE_MAX)
+    {
+        /* not indexed yet, the next sync finds it */
+        return;
+    }
+
+    wrapView->requests[index].width = NAN;
+
+    if (index < wrapView->firstDirty)
+    {
+        wrapView->firstDirty = index;
+    }
+
+    if (index > wrapView->lastDirty)
+    {
+        wrapView->lastDirty = index;
+    }
+}
+
+/* Logs the edit with the slot it was made at, so the sync can replay it on
+   the arrays instead of walking the list. */
+static void ChildListCallback(nkView_t *view, nkView_t *child, bool added)
+{
+    nkWrapView_t *wrapView = (nkWrapView_t *)view->data;
+
+    if (!wrapView || view->dataSize != sizeof(nkWrapView_t))
+    {
+        return;
+    }
+
+    if (added)
+    {
+        /* no slot until the next sync */
+        child->containerIndex = SIZE_MAX;
+    }
+
+    /* without a valid index the sync walks the whole list anyway */
+    if (!wrapView->indexValid || wrapView->editCount == SIZE_MAX)
+    {
+        return;
+    }
+
+    size_t index = 0;
+
+    if (!added)
+    {
+        index = EditedIndexOf(wrapView, child);
+    }
+    else if (child->prevSibling != NULL)
+    {
+        index = EditedIndexOf(wrapView, child->prevSibling);
+        index = (index != SIZE_MAX) ? index + 1 : SIZE_MAX;
+    }
+
+    if (index == SIZE_MAX || wrapView->editCount == NK_WRAP_EDIT_MAX)
+    {
+        wrapView->editCount = SIZE_MAX;
+        return;
+    }
+
+    wrapView->edits[wrapView->editCount++] = (nkWrapEdit_t){child, index, added};
+}
+
+/* child's slot in the list as the logged edits left it, SIZE_MAX if unknown */
+static size_t EditedIndexOf(nkWrapView_t *wrapView, nkView_t *child)
+{
+    size_t edit = wrapView->editCount;
+    size_t index;
+
+    while (edit > 0 && wrapView->edits[edit - 1].child != child)
+    {
+        edit--;
+    }
+
+    if (edit > 0)
+    {
+        index = wrapView->edits[edit - 1].added ? wrapView->edits[edit - 1].index : SIZE_MAX;
+    }
+    else
+    {
+        index = IndexOf(wrapView, child);
+    }
+
+    for (; edit < wrapView->editCount && index != SIZE_MAX; edit++)
+    {
+        const nkWrapEdit_t *later = &wrapView->edits[edit];
+
+        if (later->added && later->index <= index)
+        {
+            index++;
+        }
+        else if (!later->added && later->index < index)
+        {
+            index--;
+        }
+    }
+
+    return index;
+}
+
+static bool IndexCurrent(nkWrapView_t *wrapView)
+{
+    return wrapView->indexValid && wrapView->indexedStructureVersion == wrapView->view.structureVersion;
+}
+
+/* Re-indexes the children after the list changed. Logged edits are replayed
+   on the arrays; past too many, or without a valid index, the list is walked
+   instead, skipping the children that match at either end. Either way the
+   children that only shifted keep their requests, and the kept tail's move
+   is left in tailShift for the next reflow. */
+static bool SyncChildren(nkWrapView_t *wrapView)
+{
+    bool wasValid = wrapView->indexValid;
+    size_t oldCount = wasValid ? wrapView->childCount : 0;
+    size_t count = wrapView->view.childCount;
+    size_t first = 0;
+    size_t kept = 0;
+    bool replay = wasValid && wrapView->editCount != SIZE_MAX && wrapView->editCount > 0;
+
+    if (replay && !ReserveChildren(wrapView, oldCount + wrapView->editCount))
+    {
+        wrapView->editCount = 0;
+        wrapView->indexValid = false;
+        return false;
+    }
+
+    if (replay && !ReplayEdits(wrapView, &first, &kept))
+    {
+        /* the log missed an edit, so the arrays can't be trusted */
+        replay = false;
+        wasValid = false;
+        oldCount = 0;
+    }
+
+    wrapView->editCount = 0;
+
+    if (!replay)
+    {
+        nkView_t *child = wrapView->view.child;
+
+        while (first < oldCount && child != NULL && wrapView->children[first] == child)
+        {
+            first++;
+            child = child->sibling;
+        }
+
+        nkView_t *tail = wrapView->view.lastChild;
+
+        while (kept < oldCount - first && kept < count - first && wrapView->children[oldCount - 1 - kept] == tail)
+        {
+            kept++;
+            tail = tail->prevSibling;
+        }
+
+        if (!ReserveChildren(wrapView, count))
+        {
+            wrapView->indexValid = false;
+            return false;
+        }
+
+        if (count != oldCount)
+        {
+            memmove(&wrapView->children[count - kept], &wrapView->children[oldCount - kept], kept * sizeof(nkView_t *));
+            memmove(&wrapView->requests[count - kept], &wrapView->requests[oldCount - kept], kept * sizeof(nkSize_t));
+        }
+
+        for (size_t i = first; i < count - kept; i++, child = child->sibling)
+        {
+            wrapView->children[i] = child;
+            wrapView->requests[i] = (nkSize_t){NAN, NAN};
+            child->containerIndex = i;
+        }
+    }
+
+    ptrdiff_t shift = (ptrdiff_t)count - (ptrdiff_t)oldCount;
+    size_t lastNew = (count - kept > first) ? count - kept - 1 : first;
+
+    if (!wasValid)
+    {
+        wrapView->firstDirty = 0;
+        wrapView->lastDirty = SIZE_MAX;
+    }
+    else if (wrapView->firstDirty == SIZE_MAX)
+    {
+        wrapView->firstDirty = first;
+        wrapView->lastDirty = lastNew;
+    }
+    else if (wrapView->lastDirty != SIZE_MAX)
+    {
+        /* an earlier change still pending, which moves with the tail */
+        size_t lastDirty = wrapView->lastDirty;
+
+        if (lastDirty >= oldCount - kept)
+        {
+            lastDirty = (size_t)((ptrdiff_t)lastDirty + shift);
+        }
+
+        wrapView->firstDirty = (first < wrapView->firstDirty) ? first : wrapView->firstDirty;
+        wrapView->lastDirty = (lastDirty > lastNew) ? lastDirty : lastNew;
+    }
+    else if (first < wrapView->firstDirty)
+    {
+        wrapView->firstDirty = first;
+    }
+
+    wrapView->tailShift += shift;
+    wrapView->childCount = count;
+    wrapView->indexedStructureVersion = wrapView->view.structureVersion;
+    wrapView->indexValid = true;
+
+    return true;
+}
+
+/* Applies the logged edits to the arrays. first is set to the lowest slot
+   they touched and kept to the children after the highest, which are the
+   old tail moved along. */
+static bool ReplayEdits(nkWrapView_t *wrapView, size_t *first, size_t *kept)
+{
+    size_t count = wrapView->childCount;
+    size_t low = SIZE_MAX;
+    size_t high = 0;
+
+    for (size_t i = 0; i < wrapView->editCount; i++)
+    {
+        const nkWrapEdit_t *edit = &wrapView->edits[i];
+        size_t index = edit->index;
+
+        if (edit->added ? index > count : index >= count)
+        {
+            wrapView->childCount = count;
+            return false;
+        }
+
+        if (edit->added)
+        {
+            memmove(&wrapView->children[index + 1], &wrapView->children[index], (count - index) * sizeof(nkView_t *));
+            memmove(&wrapView->requests[index + 1], &wrapView->requests[index], (count - index) * sizeof(nkSize_t));
+            wrapView->children[index] = edit->child;
+            wrapView->requests[index] = (nkSize_t){NAN, NAN};
+            edit->child->containerIndex = index;
+            count++;
+
+            high = (low != SIZE_MAX && index <= high) ? high + 1 : high;
+        }
+        else
+        {
+            memmove(&wrapView->children[index], &wrapView->children[index + 1], (count - index - 1) * sizeof(nkView_t *));
+            memmove(&wrapView->requests[index], &wrapView->requests[index + 1], (count - index - 1) * sizeof(nkSize_t));
+            count--;
+
+            high = (low != SIZE_MAX && index < high) ? high - 1 : high;
+        }
+
+        low = (index < low) ? index : low;
+        high = (index > high) ? index : high;
+    }
+
+    wrapView->childCount = count;
+
+    if (count != wrapView->view.childCount)
+    {
+        return false;
+    }
+
+    *first = (low < count) ? low : count;
+    *kept = (high < count) ? count - 1 - high : 0;
+
+    return true;
+}
+
+/* child's slot in the arrays, or SIZE_MAX if it has none. containerIndex is
+   only a hint, as replayed edits shift children without touching them, so a
+   miss looks outward from it to where the child has drifted. */
+static size_t IndexOf(nkWrapView_t *wrapView, nkView_t *child)
+{
+    size_t count = wrapView->childCount;
+    size_t hint = child->containerIndex;
+
+    if (hint == SIZE_MAX || count == 0)
+    {
+        return SIZE_MAX;
+    }
+
+    hint = (hint < count) ? hint : count - 1;
+
+    for (size_t distance = 0; distance <= hint || hint + distance < count; distance++)
+    {
+        size_t index = SIZE_MAX;
+
+        if (distance <= hint && wrapView->children[hint - distance] == child)
+        {
+            index = hint - distance;
+        }
+        else if (hint + distance < count && wrapView->children[hint + distance] == child)
+        {
+            index = hint + distance;
+        }
+
+        if (index != SIZE_MAX)
+        {
+            child->containerIndex = index;
+            return index;
+        }
+    }
+
+    return SIZE_MAX;
+}
+
+/* Flows from the line holding the first changed child. Once past the last
+   changed child, a line starting at the same child as before means every
+   later line is unchanged apart from its cross offset, so they are copied
+   over instead of flowed. */
+static bool Reflow(nkWrapView_t *wrapView, float length, nkDrawContext_t *context)
+{
+    size_t count = wrapView->childCount;
+
+    if (!ReserveLines(wrapView, (count > 0) ? count : 1))
+    {
+        return false;
+    }
+
+    size_t firstDirty = (wrapView->firstDirty < count) ? wrapView->firstDirty : ((count > 0) ? count - 1 : 0);
+    size_t lastDirty = wrapView->lastDirty;
+    ptrdiff_t shift = wrapView->tailShift;
+
+    nkWrapLine_t *old = wrapView->lines;
+    nkWrapLine_t *lines = wrapView->spareLines;
+    size_t oldCount = wrapView->lineCount;
+
+    size_t startLine = (oldCount > 0) ? LineAt(wrapView, firstDirty) : 0;
+
+    /* a line's first child may now fit at the end of the line before */
+    if (startLine > 0 && old[startLine].first == firstDirty)
+    {
+        startLine--;
+    }
+
+    size_t lineCount = startLine;
+    size_t oldLine = startLine;
+    size_t tailStart = SIZE_MAX;
+    float tailDelta = 0.0f;
+
+    memcpy(lines, old, startLine * sizeof(nkWrapLine_t));
+
+    float crossOffset = (startLine > 0) ? old[startLine - 1].crossOffset + old[startLine - 1].crossSize : 0.0f;
+    size_t i = (startLine < oldCount) ? old[startLine].first : 0;
+
+    uint32_t unplaced = wrapView->placementVersion - 1;
+    nkWrapLine_t line = {i, 0, crossOffset, 0.0f, 0.0f, crossOffset, unplaced};
+
+    for (; i < count; i++)
+    {
+        if (i >= firstDirty && i <= lastDirty && (lastDirty == SIZE_MAX || isnan(wrapView->requests[i].width)))
+        {
+            nkView_t *child = wrapView->children[i];
+            nkSize_t childAvailable = {INFINITY, INFINITY};
+
+            if (wrapView->orientation == WRAP_ORIENTATION_HORIZONTAL)
+            {
+                childAvailable.width = fmaxf(0.0f, length - child->margin.left - child->margin.right);
+            }
+            else
+            {
+                childAvailable.height = fmaxf(0.0f, length - child->margin.top - child->margin.bottom);
+            }
+
+            nkSize_t marginRequest = nkView_Measure(child, childAvailable, context);
+            marginRequest.width += child->margin.left + child->margin.right;
+            marginRequest.height += child->margin.top + child->margin.bottom;
+
+            wrapView->requests[i] = marginRequest;
+        }
+
+        float main = MainOf(wrapView, wrapView->requests[i]);
+
+        if (i > line.first && line.mainSize + main > length)
+        {
+            lines[lineCount++] = line;
+            crossOffset += line.crossSize;
+
+            if (i > lastDirty)
+            {
+                while (oldLine < oldCount && (ptrdiff_t)old[oldLine].first + shift < (ptrdiff_t)i)
+                {
+                    oldLine++;
+                }
+
+                if (oldLine < oldCount && (ptrdiff_t)old[oldLine].first + shift == (ptrdiff_t)i)
+                {
+                    tailStart = lineCount;
+                    tailDelta = crossOffset - old[oldLine].crossOffset;
+                    break;
+                }
+            }
+
+            line = (nkWrapLine_t){i, 0, crossOffset, 0.0f, 0.0f, crossOffset, unplaced};
+        }
+
+        line.count++;
+        line.mainSize += main;
+        line.crossSize = fmaxf(line.crossSize, CrossOf(wrapView, wrapView->requests[i]));
+    }
+
+    if (tailStart != SIZE_MAX)
+    {
+        for (; oldLine < oldCount; oldLine++)
+        {
+            lines[lineCount] = old[oldLine];
+            lines[lineCount].first = (size_t)((ptrdiff_t)old[oldLine].first + shift);
+            lines[lineCount].crossOffset += tailDelta;
+            lineCount++;
+        }
+    }
+    else if (line.count > 0)
+    {
+        lines[lineCount++] = line;
+    }
+
+    wrapView->spareLines = old;
+    wrapView->lines = lines;
+    wrapView->lineCount = lineCount;
+    wrapView->flowLength = length;
+    wrapView->firstDirty = SIZE_MAX;
+    wrapView->lastDirty = 0;
+    wrapView->tailShift = 0;
+
+    return true;
+}
+
+static void PlaceLines(nkWrapView_t *wrapView, size_t first, size_t last)
+{
+    nkRect_t frame = wrapView->view.frame;
+    bool horizontal = wrapView->orientation == WRAP_ORIENTATION_HORIZONTAL;
+
+    if (last > wrapView->lineCount)
+    {
+        last = wrapView->lineCount;
+    }
+
+    for (size_t l = first; l < last; l++)
+    {
+        nkWrapLine_t *line = &wrapView->lines[l];
+        float position = 0.0f;
+
+        if (line->placedVersion == wrapView->placementVersion && line->placedOffset == line->crossOffset)
+        {
+            continue;
+        }
+
+        line->placedVersion = wrapView->placementVersion;
+        line->placedOffset = line->crossOffset;
+
+        for (size_t i = line->first; i < line->first + line->count; i++)
+        {
+            float main = MainOf(wrapView, wrapView->requests[i]);
+
+            if (horizontal)
+            {
+                nkView_PlaceView(wrapView->children[i], (nkRect_t){frame.x + position, frame.y + line->crossOffset, main, line->crossSize});
+            }
+            else
+            {
+                nkView_PlaceView(wrapView->children[i], (nkRect_t){frame.x + line->crossOffset, frame.y + position, line->crossSize, main});
+            }
+
+            position += main;
+        }
+    }
+}
+
+/* lines from first up to the returned end that overlap region on the
+   cross axis */
+static size_t FindLines(nkWrapView_t *wrapView, nkRect_t region, size_t *first)
+{
+    nkRect_t frame = wrapView->view.frame;
+    float start, end;
+
+    if (wrapView->orientation == WRAP_ORIENTATION_HORIZONTAL)
+    {
+        start = region.y - frame.y;
+        end = start + region.height;
+    }
+    else
+    {
+        start = region.x - frame.x;
+        end = start + region.width;
+    }
+
+    /* first line ending past start */
+    size_t low = 0;
+    size_t high = wrapView->lineCount;
+
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        nkWrapLine_t *line = &wrapView->lines[middle];
+
+        if (line->crossOffset + line->crossSize > start)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+
+    size_t last = low;
+
+    while (last < wrapView->lineCount && wrapView->lines[last].crossOffset <= end)
+    {
+        last++;
+    }
+
+    *first = low;
+
+    return last;
+}
+
+/* last line starting at or before child index */
+static size_t LineAt(nkWrapView_t *wrapView, size_t index)
+{
+    size_t low = 0;
+    size_t high = wrapView->lineCount;
+
+    while (high - low > 1)
+    {
+        size_t middle = low + (high - low) / 2;
+
+        if (wrapView->lines[middle].first <= index)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+static bool LinesCurrent(nkWrapView_t *wrapView)
+{
+    return IndexCurrent(wrapView) && wrapView->firstDirty == SIZE_MAX;
+}
+
+static float MainOf(nkWrapView_t *wrapView, nkSize_t size)
+{
+    return (wrapView->orientation == WRAP_ORIENTATION_HORIZONTAL) ? size.width : size.height;
+}
+
+static float CrossOf(nkWrapView_t *wrapView, nkSize_t size)
+{
+    return (wrapView->orientation == WRAP_ORIENTATION_HORIZONTAL) ? size.height : size.width;
+}
+
+static bool ReserveChildren(nkWrapView_t *wrapView, size_t needed)
+{
+    if (needed <= wrapView->childCapacity)
+    {
+        return true;
+    }
+
+    size_t capacity = (wrapView->childCapacity > 0) ? wrapView->childCapacity * 2 : 16;
+
+    while (capacity < needed)
+    {
+        capacity *= 2;
+    }
+
+    nkView_t **children = realloc(wrapView->children, capacity * sizeof(nkView_t *));
+
+    if (children == NULL)
+    {
+        return false;
+    }
+
+    wrapView->children = children;
+
+    nkSize_t *requests = realloc(wrapView->requests, capacity * sizeof(nkSize_t));
+
+    if (requests == NULL)
+    {
+        return false;
+    }
+
+    wrapView->requests = requests;
+    wrapView->childCapacity = capacity;
+
+    return true;
+}
+
+static bool ReserveLines(nkWrapView_t *wrapView, size_t needed)
+{
+    if (needed <= wrapView->lineCapacity)
+    {
+        return true;
+    }
+
+    size_t capacity = (wrapView->lineCapacity > 0) ? wrapView->lineCapacity * 2 : 16;
+
+    while (capacity < needed)
+    {
+        capacity *= 2;
+    }
+
+    nkWrapLine_t *lines = realloc(wrapView->lines, capacity * sizeof(nkWrapLine_t));
+
+    if (lines == NULL)
+    {
+        return false;
+    }
+
+    wrapView->lines = lines;
+
+    nkWrapLine_t *spareLines = realloc(wrapView->spareLines, capacity * sizeof(nkWrapLine_t));
+
+    if (spareLines == NULL)
+    {
+        return false;
+    }
+
+    wrapView->spareLines = spareLines;
+    wrapView->lineCapacity = capacity;
+
+    return true;
+}
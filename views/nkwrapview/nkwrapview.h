@@ -0,0 +1,103 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nkwrapview.h
+** Module       :  views
+** Author       :  SH
+** Created      :  2025-09-11 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Wrap View header file
+**
+***************************************************************/
+
+#ifndef NKWRAPVIEW_H
+#define NKWRAPVIEW_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <nanoview.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define NK_WRAP_EDIT_MAX 8 /* child list edits replayed between syncs before falling back to a walk */
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef enum
+{
+    WRAP_ORIENTATION_HORIZONTAL, /* fills rows left to right, rows go down */
+    WRAP_ORIENTATION_VERTICAL    /* fills columns top to bottom, columns go right */
+} nkWrapOrientation_t;
+
+typedef struct
+{
+    nkView_t *child;
+    size_t index;           /* slot in the child list when the edit was made */
+    bool added;
+} nkWrapEdit_t;
+
+typedef struct
+{
+    size_t first;           /* first child in the line */
+    size_t count;
+    float crossOffset;      /* from the view's origin, across the lines */
+    float crossSize;
+    float mainSize;
+    float placedOffset;     /* crossOffset the children were last placed at */
+    uint32_t placedVersion; /* placementVersion they were placed at */
+} nkWrapLine_t;
+
+typedef struct
+{
+    nkView_t view;          /* view */
+
+    nkWrapOrientation_t orientation;
+
+    /* children in order, with their requests including margins */
+    nkView_t **children;
+    nkSize_t *requests;
+    size_t childCount;
+    size_t childCapacity;
+
+    nkWrapLine_t *lines;
+    nkWrapLine_t *spareLines; /* reflow builds into this and swaps */
+    size_t lineCount;
+    size_t lineCapacity;
+
+    float flowLength;       /* main-axis length the lines were flowed for */
+    size_t firstDirty;      /* children from firstDirty to lastDirty reflow, SIZE_MAX if none; NaN requests are measured again */
+    size_t lastDirty;
+    ptrdiff_t tailShift;    /* lines past lastDirty now start this many children later, after inserts and removals */
+    nkWrapEdit_t edits[NK_WRAP_EDIT_MAX]; /* child list edits since the last sync */
+    size_t editCount;       /* SIZE_MAX once more were made than fit */
+    nkRect_t placedFrame;   /* frame the lines were last placed in */
+    uint32_t placementVersion; /* bumped whenever every line may be stale */
+    uint32_t indexedStructureVersion;
+    bool indexValid;
+} nkWrapView_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* Children are laid out along the main axis and wrap onto a new line when
+   the next one does not fit. A change to one child reflows from its line
+   and stops as soon as the lines after it come out as before. Like the
+   canvas view, only lines that can be seen are placed. */
+bool nkWrapView_Create(nkWrapView_t *wrapView);
+
+void nkWrapView_Destroy(nkWrapView_t *wrapView);
+
+void nkWrapView_SetOrientation(nkWrapView_t *wrapView, nkWrapOrientation_t orientation);
+
+/* line holding child as of the last layout, SIZE_MAX if it has none */
+size_t nkWrapView_LineOfChild(nkWrapView_t *wrapView, nkView_t *child);
+
+#endif /* NKWRAPVIEW_H */
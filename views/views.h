@@ -20,8 +20,12 @@
 
 #include "nkdockview/nkdockview.h"  
 #include "nkstackview/nkstackview.h"  
+#include "nkgridview/nkgridview.h"
+#include "nkcanvasview/nkcanvasview.h"
+#include "nkwrapview/nkwrapview.h"
 #include "nkscrollview/nkscrollview.h"
 
+#include "nkstyle/nkstyle.h"
 #include "nkbutton/nkbutton.h"
 #include "nklabel/nklabel.h"
 